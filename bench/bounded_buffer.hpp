@@ -1,4 +1,5 @@
 #pragma once
+// the mutex based queue which SpscRing and MpmcRing replaced. only kept as the baseline for the benchmarks.
 #include <boost/call_traits.hpp>
 #include <boost/circular_buffer.hpp>
 #include <condition_variable>
@@ -0,0 +1,227 @@
+#include <filesystem>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <dt/df/core/base_node.hpp>
+#include <dt/df/core/base_slot.hpp>
+#include <imgui.h>
+#include <imnodes.h>
+#include "graph_impl.hpp"
+#include "synthetic_nodes.hpp"
+
+using namespace dt::df;
+using namespace dt::df::editor;
+
+namespace
+{
+constexpr std::size_t kColumns = 300;
+constexpr int kNodeSpacing = 200;
+
+//! ImGui and imnodes contexts without any renderer
+class HeadlessGui
+{
+  public:
+    HeadlessGui()
+        : imgui_{ImGui::CreateContext()}
+        , imnodes_{imnodes::CreateContext()}
+    {
+        auto &io = ImGui::GetIO();
+        io.DisplaySize = ImVec2{1920.f, 1080.f};
+        io.DeltaTime = 1.f / 60.f;
+        // NewFrame needs a built font atlas
+        unsigned char *pixels;
+        int width;
+        int height;
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    }
+    HeadlessGui(const HeadlessGui &) = delete;
+    HeadlessGui &operator=(const HeadlessGui &) = delete;
+    ~HeadlessGui()
+    {
+        imnodes::DestroyContext(imnodes_);
+        ImGui::DestroyContext(imgui_);
+    }
+
+    void frame(GraphImpl &graph)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2{0.f, 0.f});
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("graph");
+        imnodes::BeginNodeEditor();
+        graph.renderNodes();
+        graph.renderLinks();
+        imnodes::EndNodeEditor();
+        ImGui::End();
+        ImGui::Render();
+    }
+
+  private:
+    ImGuiContext *imgui_;
+    imnodes::Context *imnodes_;
+};
+
+SlotId inputOf(const GraphImpl &graph, const NodeId node)
+{
+    return graph.findNodeById(node)->inputs().begin()->first;
+}
+
+SlotId outputOf(const GraphImpl &graph, const NodeId node)
+{
+    return graph.findNodeById(node)->outputs().begin()->first;
+}
+
+EdgeId connect(GraphImpl &graph, const NodeId from, const NodeId to)
+{
+    return graph.addEdge(graph.findVertexById(outputOf(graph, from)), graph.findVertexById(inputOf(graph, to)));
+}
+
+NodeId createNode(GraphImpl &graph, const std::size_t index)
+{
+    return graph.createNode(bench::kSyntheticNodeKey,
+                            static_cast<int>(index % kColumns) * kNodeSpacing,
+                            static_cast<int>(index / kColumns) * kNodeSpacing,
+                            false);
+}
+
+//! a chain of num_nodes nodes laid out on a grid, so that only a part of them is visible
+std::vector<NodeId> buildChain(GraphImpl &graph, HeadlessGui &gui, const std::size_t num_nodes)
+{
+    bench::registerSyntheticFactories(graph);
+    std::vector<NodeId> nodes;
+    nodes.reserve(num_nodes);
+    for (std::size_t i = 0; i < num_nodes; i++)
+        nodes.emplace_back(createNode(graph, i));
+    for (std::size_t i = 1; i < num_nodes; i++)
+        connect(graph, nodes[i - 1], nodes[i]);
+    // every new node is rendered once to place it in the spatial grid
+    gui.frame(graph);
+    return nodes;
+}
+} // namespace
+
+TEST_CASE("graph operations", "[graph]")
+{
+    const auto num_nodes = GENERATE(as<std::size_t>{}, 1'000, 10'000, 100'000);
+    const auto suffix = "/" + std::to_string(num_nodes);
+
+    HeadlessGui gui;
+    GraphImpl graph;
+    const auto nodes = buildChain(graph, gui, num_nodes);
+    std::mt19937 random{42};
+    std::uniform_int_distribution<std::size_t> random_node{0, num_nodes - 1};
+    // links along the chain never close a cycle, so every measured addEdge inserts a link
+    const auto random_forward_pair = [&]() {
+        const auto from = std::uniform_int_distribution<std::size_t>{0, num_nodes - 2}(random);
+        const auto to = std::uniform_int_distribution<std::size_t>{from + 1, num_nodes - 1}(random);
+        return std::pair{nodes[from], nodes[to]};
+    };
+
+    BENCHMARK_ADVANCED("createNode" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<NodeId> created(meter.runs());
+        meter.measure([&](const int i) { created[i] = createNode(graph, num_nodes + i); });
+        for (const auto id : created)
+            graph.removeNode(id);
+    };
+
+    BENCHMARK_ADVANCED("addEdge" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<std::pair<VertexDesc, VertexDesc>> slots(meter.runs());
+        for (auto &slot_pair : slots)
+        {
+            const auto [from, to] = random_forward_pair();
+            slot_pair = {graph.findVertexById(outputOf(graph, from)), graph.findVertexById(inputOf(graph, to))};
+        }
+        std::vector<EdgeId> edges(meter.runs());
+        meter.measure([&](const int i) { edges[i] = graph.addEdge(slots[i].first, slots[i].second); });
+        for (const auto edge : edges)
+        {
+            REQUIRE(edge != -1);
+            graph.removeEdge(edge);
+        }
+    };
+
+    BENCHMARK_ADVANCED("removeEdge" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<EdgeId> edges(meter.runs());
+        for (auto &edge : edges)
+        {
+            const auto [from, to] = random_forward_pair();
+            edge = connect(graph, from, to);
+            REQUIRE(edge != -1);
+        }
+        meter.measure([&](const int i) { graph.removeEdge(edges[i]); });
+    };
+
+    BENCHMARK_ADVANCED("removeNode" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<NodeId> created(meter.runs());
+        for (std::size_t i = 0; i < created.size(); i++)
+        {
+            created[i] = createNode(graph, num_nodes + i);
+            connect(graph, nodes[random_node(random)], created[i]);
+        }
+        meter.measure([&](const int i) { graph.removeNode(created[i]); });
+    };
+
+    BENCHMARK_ADVANCED("removeNodes(1000)" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        constexpr std::size_t kBatchSize = 1'000;
+        std::vector<std::vector<NodeId>> batches(meter.runs());
+        for (auto &batch : batches)
+        {
+            for (std::size_t i = 0; i < kBatchSize; i++)
+            {
+                batch.emplace_back(createNode(graph, num_nodes + i));
+                connect(graph, nodes[random_node(random)], batch.back());
+            }
+        }
+        meter.measure([&](const int i) { graph.removeNodes(batches[i]); });
+    };
+
+    BENCHMARK_ADVANCED("findVertexById" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<NodeId> ids(meter.runs());
+        for (auto &id : ids)
+            id = nodes[random_node(random)];
+        meter.measure([&](const int i) { return graph.findVertexById(ids[i]); });
+    };
+
+    BENCHMARK("renderNodes+renderLinks" + suffix)
+    {
+        gui.frame(graph);
+    };
+
+    const auto bench_dir = std::filesystem::temp_directory_path() / "dtdfeditor_bench";
+    std::filesystem::create_directories(bench_dir);
+    const auto json_file = bench_dir / ("graph" + std::to_string(num_nodes) + ".json");
+    const auto snapshot_file = bench_dir / ("graph" + std::to_string(num_nodes) + ".dtdf");
+
+    BENCHMARK("save json" + suffix)
+    {
+        graph.save(json_file);
+    };
+    BENCHMARK("save snapshot" + suffix)
+    {
+        graph.save(snapshot_file);
+    };
+    BENCHMARK("load json" + suffix)
+    {
+        graph.clearAndLoad(json_file, LoadMode::sequential);
+    };
+    BENCHMARK("load snapshot" + suffix)
+    {
+        graph.clearAndLoad(snapshot_file, LoadMode::sequential);
+    };
+    BENCHMARK("load snapshot parallel" + suffix)
+    {
+        graph.clearAndLoad(snapshot_file, LoadMode::parallel);
+    };
+
+    std::filesystem::remove_all(bench_dir);
+}
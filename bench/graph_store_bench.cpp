@@ -0,0 +1,155 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <boost/graph/adjacency_list.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "graph_store.hpp"
+
+using namespace dt::df;
+using namespace dt::df::editor;
+
+namespace
+{
+//! the graph type GraphStore replaced
+struct BoostEdgeInfo
+{
+    EdgeId id;
+};
+using BoostGraph =
+    boost::adjacency_list<boost::vecS, boost::vecS, boost::bidirectionalS, VertexInfo, BoostEdgeInfo>;
+
+constexpr std::size_t kSlotsPerNode = 2;
+
+//! same layout as GraphImpl: every node vertex is followed by an input and an output slot and the output of each node
+//! is linked to the input of the next one
+template <typename AddVertex, typename AddEdge>
+void buildChain(const std::size_t num_nodes, AddVertex &&add_vertex, AddEdge &&add_edge)
+{
+    int id = 0;
+    for (std::size_t i = 0; i < num_nodes; i++)
+    {
+        const auto node_id = id++;
+        const auto node = add_vertex(VertexInfo{node_id, -1, VertexType::node});
+        const auto input = add_vertex(VertexInfo{id++, node_id, VertexType::input});
+        const auto output = add_vertex(VertexInfo{id++, node_id, VertexType::output});
+        add_edge(input, node, id++);
+        add_edge(node, output, id++);
+    }
+    for (std::size_t i = 1; i < num_nodes; i++)
+        add_edge((i - 1) * (kSlotsPerNode + 1) + 2, i * (kSlotsPerNode + 1) + 1, id++);
+}
+} // namespace
+
+TEST_CASE("graph store vs boost::adjacency_list", "[graph_store]")
+{
+    const auto num_nodes = GENERATE(as<std::size_t>{}, 1'000, 10'000, 100'000);
+    const auto suffix = "/" + std::to_string(num_nodes);
+
+    BoostGraph boost_graph;
+    buildChain(
+        num_nodes,
+        [&](const VertexInfo &info) { return boost::add_vertex(info, boost_graph); },
+        [&](const std::size_t from, const std::size_t to, const int id) {
+            boost::add_edge(from, to, BoostEdgeInfo{id}, boost_graph);
+        });
+    GraphStore store;
+    buildChain(
+        num_nodes,
+        [&](const VertexInfo &info) { return store.addVertex(info); },
+        [&](const std::size_t from, const std::size_t to, const int id) {
+            store.addEdge(static_cast<VertexDesc>(from), static_cast<VertexDesc>(to), EdgeInfo{id, RefCon{}});
+        });
+
+    const auto num_vertices = num_nodes * (kSlotsPerNode + 1);
+    std::mt19937 random{42};
+    std::uniform_int_distribution<std::size_t> random_vertex{0, num_vertices - 1};
+    std::vector<std::size_t> lookups(4096);
+    for (auto &vertex : lookups)
+        vertex = random_vertex(random);
+
+    // findSlotById: type and parent of a vertex found through the id index
+    BENCHMARK("vertex lookup boost" + suffix)
+    {
+        NodeId sum = 0;
+        for (const auto vertex : lookups)
+        {
+            if (boost_graph[vertex].type != VertexType::node)
+                sum += boost_graph[vertex].parent_id;
+        }
+        return sum;
+    };
+    BENCHMARK("vertex lookup store" + suffix)
+    {
+        NodeId sum = 0;
+        for (const auto vertex : lookups)
+        {
+            if (store.type(static_cast<VertexDesc>(vertex)) != VertexType::node)
+                sum += store.parentId(static_cast<VertexDesc>(vertex));
+        }
+        return sum;
+    };
+
+    // compaction and index rebuilds walk over every vertex
+    BENCHMARK("vertex scan boost" + suffix)
+    {
+        long long sum = 0;
+        for (const auto vertex : boost::make_iterator_range(boost::vertices(boost_graph)))
+            sum += boost_graph[vertex].id;
+        return sum;
+    };
+    BENCHMARK("vertex scan store" + suffix)
+    {
+        long long sum = 0;
+        for (VertexDesc vertex = 0; vertex < store.numVertices(); vertex++)
+            sum += store.id(vertex);
+        return sum;
+    };
+
+    // findLink, removeSlot and removeNode walk the edges of a vertex
+    BENCHMARK("out edges boost" + suffix)
+    {
+        long long sum = 0;
+        for (const auto vertex : lookups)
+        {
+            for (const auto &edge : boost::make_iterator_range(boost::out_edges(vertex, boost_graph)))
+                sum += boost_graph[boost::target(edge, boost_graph)].id;
+        }
+        return sum;
+    };
+    BENCHMARK("out edges store" + suffix)
+    {
+        long long sum = 0;
+        for (const auto vertex : lookups)
+        {
+            store.forEachOutEdge(static_cast<VertexDesc>(vertex),
+                                 [&](const EdgeDesc edge) { sum += store.id(store.target(edge)); });
+        }
+        return sum;
+    };
+
+    // the edges are removed again outside of the measurement
+    BENCHMARK_ADVANCED("addEdge boost" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<BoostGraph::edge_descriptor> edges(meter.runs());
+        meter.measure([&](const int i) {
+            edges[i] = boost::add_edge(lookups[i % lookups.size()], lookups[(i + 1) % lookups.size()],
+                                       BoostEdgeInfo{i}, boost_graph)
+                           .first;
+        });
+        for (const auto &edge : edges)
+            boost::remove_edge(edge, boost_graph);
+    };
+    BENCHMARK_ADVANCED("addEdge store" + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<EdgeDesc> edges(meter.runs());
+        meter.measure([&](const int i) {
+            edges[i] = store.addEdge(static_cast<VertexDesc>(lookups[i % lookups.size()]),
+                                     static_cast<VertexDesc>(lookups[(i + 1) % lookups.size()]),
+                                     EdgeInfo{i, RefCon{}});
+        });
+        for (const auto edge : edges)
+            store.removeEdge(edge);
+    };
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "bounded_buffer.hpp"
+#include "ring_buffer.hpp"
+
+using namespace dt::df::editor;
+
+namespace
+{
+constexpr std::size_t kCapacity = 1024;
+constexpr std::uint64_t kItems = 100'000;
+constexpr std::size_t kBatchSize = 64;
+
+//! moves kItems from one producer thread to the calling thread and returns the checksum
+template <typename PushFnc, typename PopFnc>
+std::uint64_t transfer(PushFnc &&push, PopFnc &&pop)
+{
+    std::jthread producer{[&push] {
+        for (std::uint64_t i = 0; i < kItems; i++)
+            push(i);
+    }};
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < kItems; i++)
+        sum += pop();
+    return sum;
+}
+} // namespace
+
+TEST_CASE("single producer, single consumer", "[ring_buffer]")
+{
+    BENCHMARK("bounded_buffer")
+    {
+        bounded_buffer<std::uint64_t> queue{kCapacity};
+        return transfer([&queue](std::uint64_t item) { queue.push_front(item); },
+                        [&queue] {
+                            std::uint64_t item;
+                            queue.pop_back(&item);
+                            return item;
+                        });
+    };
+    BENCHMARK("SpscRing spin_then_park")
+    {
+        SpscRing<std::uint64_t> queue{kCapacity};
+        return transfer([&queue](std::uint64_t item) { queue.push(item); }, [&queue] { return queue.pop(); });
+    };
+    BENCHMARK("SpscRing yield")
+    {
+        SpscRing<std::uint64_t> queue{kCapacity, WaitStrategy::yield};
+        return transfer([&queue](std::uint64_t item) { queue.push(item); }, [&queue] { return queue.pop(); });
+    };
+    BENCHMARK("MpmcRing spin_then_park")
+    {
+        MpmcRing<std::uint64_t> queue{kCapacity};
+        return transfer([&queue](std::uint64_t item) { queue.push(item); }, [&queue] { return queue.pop(); });
+    };
+}
+
+TEST_CASE("single producer, single consumer, batched", "[ring_buffer]")
+{
+    BENCHMARK("SpscRing batch")
+    {
+        SpscRing<std::uint64_t> queue{kCapacity};
+        std::jthread producer{[&queue] {
+            std::array<std::uint64_t, kBatchSize> batch;
+            for (std::uint64_t i = 0; i < kItems; i += kBatchSize)
+            {
+                for (std::size_t k = 0; k < kBatchSize; k++)
+                    batch[k] = i + k;
+                queue.push(std::span<const std::uint64_t>{batch.data(), std::min<std::size_t>(kBatchSize, kItems - i)});
+            }
+        }};
+        std::array<std::uint64_t, kBatchSize> batch;
+        std::uint64_t sum = 0;
+        for (std::uint64_t received = 0; received < kItems;)
+        {
+            const auto count = queue.pop(std::span<std::uint64_t>{batch});
+            for (std::size_t k = 0; k < count; k++)
+                sum += batch[k];
+            received += count;
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("multiple producers, multiple consumers", "[ring_buffer]")
+{
+    constexpr int kThreads = 2;
+    constexpr std::uint64_t kItemsPerThread = kItems / kThreads;
+
+    BENCHMARK("MpmcRing 2x2")
+    {
+        MpmcRing<std::uint64_t> queue{kCapacity};
+        std::array<std::uint64_t, kThreads> sums{};
+        {
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < kThreads; t++)
+            {
+                threads.emplace_back([&queue] {
+                    for (std::uint64_t i = 0; i < kItemsPerThread; i++)
+                        queue.push(i);
+                });
+                threads.emplace_back([&queue, &sum = sums[t]] {
+                    for (std::uint64_t i = 0; i < kItemsPerThread; i++)
+                        sum += queue.pop();
+                });
+            }
+        }
+        return sums[0] + sums[1];
+    };
+}
+
+TEST_CASE("uncontended try operations", "[ring_buffer]")
+{
+    SpscRing<std::uint64_t> spsc{kCapacity};
+    MpmcRing<std::uint64_t> mpmc{kCapacity};
+    BENCHMARK("SpscRing tryPush/tryPop")
+    {
+        std::uint64_t item = 0;
+        spsc.tryPush(std::uint64_t{42});
+        spsc.tryPop(item);
+        return item;
+    };
+    BENCHMARK("MpmcRing tryPush/tryPop")
+    {
+        std::uint64_t item = 0;
+        mpmc.tryPush(std::uint64_t{42});
+        mpmc.tryPop(item);
+        return item;
+    };
+}
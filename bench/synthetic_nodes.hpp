@@ -0,0 +1,50 @@
+#pragma once
+#include <memory>
+#include <dt/df/core/base_node.hpp>
+#include <dt/df/core/base_slot.hpp>
+#include <dt/df/core/graph_manager.hpp>
+
+namespace dt::df::editor::bench
+{
+inline const SlotKey kSyntheticSlotKey{"bench.value"};
+inline const NodeKey kSyntheticNodeKey{"bench.passthrough"};
+
+class SyntheticSlot final : public core::BaseSlot
+{
+  public:
+    using core::BaseSlot::BaseSlot;
+};
+
+//! one input and one output. the editor only needs the slots, so there is nothing to compute.
+class SyntheticNode final : public core::BaseNode
+{
+  public:
+    explicit SyntheticNode(core::IGraphManager &graph_manager)
+        : core::BaseNode{graph_manager,
+                         kSyntheticNodeKey,
+                         "passthrough",
+                         Slots{graph_manager.getSlotFactory(kSyntheticSlotKey)(graph_manager, SlotType::input, "in", 0)},
+                         Slots{graph_manager.getSlotFactory(kSyntheticSlotKey)(graph_manager, SlotType::output, "out", 0)}}
+    {}
+    SyntheticNode(core::IGraphManager &graph_manager, const nlohmann::json &json)
+        : core::BaseNode{graph_manager, json}
+    {}
+};
+
+inline void registerSyntheticFactories(core::IGraphManager &graph_manager)
+{
+    graph_manager.registerSlotFactory(
+        kSyntheticSlotKey,
+        [](core::IGraphManager &graph_manager, const SlotType type, const SlotName &name, const SlotId local_id) {
+            return std::make_shared<SyntheticSlot>(kSyntheticSlotKey, graph_manager, type, name, local_id);
+        },
+        [](const nlohmann::json &json) { return std::make_shared<SyntheticSlot>(json); });
+    graph_manager.registerNodeFactory(
+        kSyntheticNodeKey,
+        "bench/passthrough",
+        [](core::IGraphManager &graph_manager) { return std::make_shared<SyntheticNode>(graph_manager); },
+        [](core::IGraphManager &graph_manager, const nlohmann::json &json) {
+            return std::make_shared<SyntheticNode>(graph_manager, json);
+        });
+}
+} // namespace dt::df::editor::bench
@@ -1,6 +1,11 @@
 #pragma once
+#include <chrono>
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <span>
+#include <string_view>
+#include <vector>
 #include <dt/df/core/types.hpp>
 #include "dtdatafloweditor_export.h"
 #include "types.hpp"
@@ -10,20 +15,95 @@ class GraphImpl;
 class DTDATAFLOWEDITOR_EXPORT DataFlowGraph
 {
   public:
-    DataFlowGraph();
+    //! records the time until its destruction as a sample of the scope
+    class DTDATAFLOWEDITOR_EXPORT ProfileScope
+    {
+      public:
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+        ~ProfileScope();
+
+      private:
+        friend DataFlowGraph;
+        ProfileScope(GraphImpl &graph, const TimingScope scope);
+
+      private:
+        GraphImpl &graph_;
+        TimingScope scope_;
+        std::chrono::steady_clock::time_point begin_;
+    };
+
+    explicit DataFlowGraph(const RuntimeMode mode = RuntimeMode::gui);
     DataFlowGraph(const DataFlowGraph &) = delete;
     DataFlowGraph &operator=(const DataFlowGraph &) = delete;
     void init();
+    //! lazy plugin activation. The palette is filled from the catalog and a plugin is only loaded once one of its
+    //! nodes is created or deserialized. Plugins missing from the catalog are loaded right away and added to it.
+    void init(const std::filesystem::path &plugin_catalog);
     void addNode(const NodeKey &key, int preferred_x = 0, int preferred_y = 0, bool screen_space = false);
     void removeNode(const NodeId id);
+    //! removes all nodes and their links at once. unknown and repeated ids are skipped.
+    void removeNodes(std::span<const NodeId> ids);
+    //! links which would close a cycle are rejected
     void addEdge(const NodeId from, const NodeId to);
     void removeEdge(const EdgeId id);
 
+    //! The queue* functions can be called from any thread. The commands are applied in order with the next
+    //! applyPendingCommands, which Editor::render calls at the start of each frame. Errors are reported through the
+    //! futures, e.g. a std::runtime_error if the queue is full or a std::out_of_range for unknown ids.
+    std::future<NodeId> queueAddNode(const NodeKey &key, int x = 0, int y = 0);
+    std::future<void> queueRemoveNode(const NodeId id);
+    //! the future holds -1 if the slots can't be connected, a std::out_of_range for unknown ids and a
+    //! std::invalid_argument if from isn't an output slot or to isn't an input slot.
+    std::future<EdgeId> queueAddEdge(const SlotId from, const SlotId to);
+    std::future<void> queueRemoveEdge(const EdgeId id);
+    //! has to be called from the thread which renders the graph
+    std::size_t applyPendingCommands();
+
+    //! runs task once for every node on a work-stealing thread pool and blocks until all are done.
+    //! A node starts after all nodes connected to its inputs are finished, independent branches run concurrently.
+    //! The first exception thrown by a task is rethrown. The run follows the topological order, which every edit
+    //! keeps up to date, so there is no schedule to rebuild. May be called from a worker of the graph's pool.
+    //! \returns the number of executed nodes
+    std::size_t execute(const NodeTask &task);
+    //! every node comes after all nodes connected to its inputs. kept up to date with every edit.
+    std::vector<NodeId> topologicalOrder() const;
+
     void render();
+    //! call after imnodes::EndNodeEditor. the pins which accept the dragged link are highlighted in the next frame.
+    void updateLinkDrag();
+    //! call after imnodes::EndNodeEditor. the selected nodes are submitted in the next frame even if they are culled.
+    void trackSelection();
+    //! nodes are drawn as title-only boxes with their pins when more than max_detailed_nodes are visible. They are
+    //! drawn in full again once the visible nodes dropped to 75% of the threshold.
+    //! 0 always renders the full nodes, which is the default.
+    void setLevelOfDetailThreshold(const std::size_t max_detailed_nodes);
     void renderNodeDisplayTree(const NodeDisplayDrawFnc &draw_fnc) const;
+    //! case insensitive fuzzy search over the keys and display names of the registered nodes, best match first.
+    //! Meant to be called on every keystroke: ranking stops once the budget is used up.
+    std::vector<NodeSearchMatch> searchNodes(std::string_view query,
+                                             const std::size_t max_results = 20,
+                                             const std::chrono::microseconds budget = std::chrono::microseconds{1000}) const;
+    //! Timings are only recorded if the library was built with DTDFEDITOR_ENABLE_PROFILING, otherwise the
+    //! stats are empty.
+    TimingStats timingStats(const TimingScope scope) const;
+    //! times the caller's block until the returned object is destroyed, e.g. to add the time spent around render()
+    [[nodiscard]] ProfileScope profileScope(const TimingScope scope);
+    //! time of the node's render() over its last frames. min and p99 are approximated to about 19%.
+    TimingStats nodeTimingStats(const NodeId id) const;
+    //! the vertex, edge, link and node records are allocated from a per graph arena, which clear() releases at once
+    AllocatorStats allocatorStats() const;
+    //! ImGui window with the scope timings and the slowest nodes
+    void renderTimingOverlay(bool *open = nullptr) const;
+    //! files with the .json extension are written as json for interchange, everything else as binary snapshot.
+    //! The graph is written to "<file>.tmp" first, which replaces the file once it is completely on disk.
     void save(const std::filesystem::path &file);
     void clear();
-    void clearAndLoad(const std::filesystem::path &file);
+    //! \see save for the file formats
+    void clearAndLoad(const std::filesystem::path &file, const LoadMode mode = LoadMode::sequential);
+    //! records every edit to "<project file>.journal" once the graph was saved or loaded.
+    //! clearAndLoad replays the journal on top of the project file, save folds it back into the project file.
+    void setJournalEnabled(const bool enabled);
 
     virtual ~DataFlowGraph();
 
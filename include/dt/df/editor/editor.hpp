@@ -15,8 +15,15 @@ class DTDATAFLOWEDITOR_EXPORT Editor
     Editor(const Editor &) = delete;
     Editor &operator=(const Editor &) = delete;
     void init();
+    //! \see DataFlowGraph::init
+    void init(const std::filesystem::path &plugin_catalog);
     void render();
+    void setLevelOfDetailThreshold(const std::size_t max_detailed_nodes);
     void renderNodeDisplayTree(const NodeDisplayDrawFnc &draw_fnc) const;
+    //! \see DataFlowGraph::searchNodes
+    std::vector<NodeSearchMatch> searchNodes(std::string_view query,
+                                             const std::size_t max_results = 20,
+                                             const std::chrono::microseconds budget = std::chrono::microseconds{1000}) const;
     DataFlowGraph &graph();
     const DataFlowGraph &graph() const;
 
@@ -1,8 +1,75 @@
 #pragma once
 #include <functional>
 #include <string>
+#include <dt/df/core/types.hpp>
 namespace dt::df::editor
 {
 using NodeDisplayDrawFnc = std::function<void(
     int prev_level, int level, bool is_leaf, const std::string &node_key, const std::string &node_name)>;
-}
+
+enum class LoadMode
+{
+    sequential,
+    //! runs the node deserialization factories on a thread pool. Nodes, links and vertices are still added in file
+    //! order. The factories may only use the lookup and id generation functions of the graph manager.
+    //! The ids only match a sequential load if the factories restore the node and slot ids from the state. Ids
+    //! which are generated instead are handed out in the order the workers get to them.
+    parallel
+};
+
+enum class RuntimeMode
+{
+    gui,
+    //! no GL, ImGui or imnodes context is needed. Plugins aren't set up, nothing is rendered and node positions
+    //! are only kept for saving.
+    headless
+};
+
+//! the instrumented code paths, see DataFlowGraph::timingStats
+enum class TimingScope
+{
+    editor_render,
+    apply_commands,
+    //! the node editor of Editor::render including renderNodes and renderLinks
+    editor_graph,
+    //! link creation, deletion and node drops of Editor::render
+    editor_interaction,
+    render_nodes,
+    render_links,
+    add_edge,
+    remove_edge,
+    remove_nodes,
+    count
+};
+
+//! rolling statistics over the last 512 samples in microseconds. p99_us is only below the maximum once more than 100
+//! samples were recorded.
+struct TimingStats
+{
+    float min_us;
+    float avg_us;
+    float p99_us;
+    std::size_t samples;
+};
+
+//! memory of the graph's vertex, edge, link and node records, see DataFlowGraph::allocatorStats
+struct AllocatorStats
+{
+    std::size_t bytes_in_use; //! requested by the graph containers
+    std::size_t peak_bytes_in_use;
+    std::size_t allocations; //! served by the pools since the graph was created
+    std::size_t reserved_bytes; //! chunks the pools currently hold from the system
+    std::size_t system_allocations; //! chunks requested from the system since the graph was created
+};
+
+//! a registered node type found by DataFlowGraph::searchNodes
+struct NodeSearchMatch
+{
+    NodeKey node_key;
+    std::string display_name; //! full path including the groups
+    int score; //! higher is better
+};
+
+//! the work which DataFlowGraph::execute does for every node
+using NodeTask = std::function<void(core::BaseNode &node)>;
+} // namespace dt::df::editor
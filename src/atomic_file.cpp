@@ -0,0 +1,66 @@
+#include "atomic_file.hpp"
+#include <stdexcept>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dt::df::editor
+{
+namespace
+{
+//! the streams only flush to the os. the data has to reach the disk before the rename makes it the project file.
+bool syncFile(const std::filesystem::path &file)
+{
+#ifdef _WIN32
+    const int fd = ::_wopen(file.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0)
+        return false;
+    const bool synced = ::_commit(fd) == 0;
+    ::_close(fd);
+#else
+    const int fd = ::open(file.c_str(), O_RDWR);
+    if (fd < 0)
+        return false;
+    const bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return synced;
+}
+
+void syncDirectory([[maybe_unused]] const std::filesystem::path &dir)
+{
+#ifndef _WIN32
+    // makes the rename itself durable. not every file system supports it, so failures are ignored.
+    const int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    ::fsync(fd);
+    ::close(fd);
+#endif
+}
+} // namespace
+
+void replaceFile(const std::filesystem::path &file, const std::function<void(const std::filesystem::path &)> &write_fnc)
+{
+    auto tmp_file = file;
+    tmp_file += ".tmp";
+    try
+    {
+        write_fnc(tmp_file);
+        if (!syncFile(tmp_file))
+            throw std::runtime_error("can't sync " + tmp_file.string());
+        std::filesystem::rename(tmp_file, file);
+    }
+    catch (...)
+    {
+        std::error_code ec;
+        std::filesystem::remove(tmp_file, ec);
+        throw;
+    }
+    syncDirectory(file.parent_path());
+}
+} // namespace dt::df::editor
@@ -0,0 +1,11 @@
+#pragma once
+#include <filesystem>
+#include <functional>
+
+namespace dt::df::editor
+{
+//! writes "<file>.tmp" with write_fnc, syncs it to disk and renames it over file. The old file stays untouched until
+//! the new one is complete. If write_fnc throws, the temporary file is removed and the exception is passed on.
+//! throws std::runtime_error if the file can't be synced or replaced.
+void replaceFile(const std::filesystem::path &file, const std::function<void(const std::filesystem::path &)> &write_fnc);
+} // namespace dt::df::editor
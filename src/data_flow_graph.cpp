@@ -3,8 +3,8 @@
 namespace dt::df::editor
 {
 
-DataFlowGraph::DataFlowGraph()
-    : impl_{new GraphImpl()}
+DataFlowGraph::DataFlowGraph(const RuntimeMode mode)
+    : impl_{new GraphImpl(mode)}
 {}
 
 void DataFlowGraph::init()
@@ -12,6 +12,11 @@ void DataFlowGraph::init()
     impl_->init();
 }
 
+void DataFlowGraph::init(const std::filesystem::path &plugin_catalog)
+{
+    impl_->init(plugin_catalog);
+}
+
 void DataFlowGraph::addNode(const NodeKey &key, int preferred_x, int preferred_y, bool screen_space)
 {
     impl_->createNode(key, preferred_x, preferred_y, screen_space);
@@ -22,6 +27,11 @@ void DataFlowGraph::removeNode(const NodeId id)
     impl_->removeNode(id);
 }
 
+void DataFlowGraph::removeNodes(std::span<const NodeId> ids)
+{
+    impl_->removeNodes(ids);
+}
+
 void DataFlowGraph::addEdge(const NodeId from, const NodeId to)
 {
     try
@@ -30,7 +40,7 @@ void DataFlowGraph::addEdge(const NodeId from, const NodeId to)
         auto to_vert = impl_->findVertexById(to);
         impl_->addEdge(from_vert, to_vert);
     }
-    catch (const std::out_of_range &)
+    catch (const std::logic_error &)
     {
         //! \todo we need to log the error
     }
@@ -41,12 +51,100 @@ void DataFlowGraph::removeEdge(const EdgeId id)
     impl_->removeEdge(id);
 }
 
+std::future<NodeId> DataFlowGraph::queueAddNode(const NodeKey &key, int x, int y)
+{
+    return impl_->enqueueCommand([key, x, y](GraphImpl &graph) { return graph.createNode(key, x, y, false); });
+}
+
+std::future<void> DataFlowGraph::queueRemoveNode(const NodeId id)
+{
+    return impl_->enqueueCommand([id](GraphImpl &graph) { graph.removeNode(id); });
+}
+
+std::future<EdgeId> DataFlowGraph::queueAddEdge(const SlotId from, const SlotId to)
+{
+    return impl_->enqueueCommand(
+        [from, to](GraphImpl &graph) { return graph.addEdge(graph.findVertexById(from), graph.findVertexById(to)); });
+}
+
+std::future<void> DataFlowGraph::queueRemoveEdge(const EdgeId id)
+{
+    return impl_->enqueueCommand([id](GraphImpl &graph) { graph.removeEdge(id); });
+}
+
+std::size_t DataFlowGraph::applyPendingCommands()
+{
+    return impl_->applyPendingCommands();
+}
+
+std::size_t DataFlowGraph::execute(const NodeTask &task)
+{
+    return impl_->execute(task);
+}
+
+TimingStats DataFlowGraph::timingStats(const TimingScope scope) const
+{
+    return impl_->timingStats(scope);
+}
+
+DataFlowGraph::ProfileScope DataFlowGraph::profileScope(const TimingScope scope)
+{
+    return ProfileScope{*impl_, scope};
+}
+
+DataFlowGraph::ProfileScope::ProfileScope(GraphImpl &graph, const TimingScope scope)
+    : graph_{graph}
+    , scope_{scope}
+    , begin_{std::chrono::steady_clock::now()}
+{}
+
+DataFlowGraph::ProfileScope::~ProfileScope()
+{
+    graph_.recordTiming(scope_,
+                        std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - begin_).count());
+}
+
+TimingStats DataFlowGraph::nodeTimingStats(const NodeId id) const
+{
+    return impl_->nodeTimingStats(id);
+}
+
+void DataFlowGraph::renderTimingOverlay(bool *open) const
+{
+    impl_->renderTimingOverlay(open);
+}
+
+AllocatorStats DataFlowGraph::allocatorStats() const
+{
+    return impl_->allocatorStats();
+}
+
+std::vector<NodeId> DataFlowGraph::topologicalOrder() const
+{
+    return impl_->topologicalOrder();
+}
+
 void DataFlowGraph::render()
 {
     impl_->renderNodes();
     impl_->renderLinks();
 }
 
+void DataFlowGraph::updateLinkDrag()
+{
+    impl_->updateLinkDrag();
+}
+
+void DataFlowGraph::trackSelection()
+{
+    impl_->trackSelection();
+}
+
+void DataFlowGraph::setLevelOfDetailThreshold(const std::size_t max_detailed_nodes)
+{
+    impl_->setLevelOfDetailThreshold(max_detailed_nodes);
+}
+
 void DataFlowGraph::save(const std::filesystem::path &file)
 {
     impl_->save(file);
@@ -57,9 +155,14 @@ void DataFlowGraph::clear()
     impl_->clear();
 }
 
-void DataFlowGraph::clearAndLoad(const std::filesystem::path &file)
+void DataFlowGraph::clearAndLoad(const std::filesystem::path &file, const LoadMode mode)
+{
+    impl_->clearAndLoad(file, mode);
+}
+
+void DataFlowGraph::setJournalEnabled(const bool enabled)
 {
-    impl_->clearAndLoad(file);
+    impl_->setJournalEnabled(enabled);
 }
 
 void DataFlowGraph::renderNodeDisplayTree(const NodeDisplayDrawFnc &draw_fnc) const
@@ -67,6 +170,13 @@ void DataFlowGraph::renderNodeDisplayTree(const NodeDisplayDrawFnc &draw_fnc) co
     impl_->nodeDisplayNames().drawTree(draw_fnc);
 }
 
+std::vector<NodeSearchMatch> DataFlowGraph::searchNodes(std::string_view query,
+                                                       const std::size_t max_results,
+                                                       const std::chrono::microseconds budget) const
+{
+    return impl_->nodeSearchIndex().search(query, max_results, budget);
+}
+
 DataFlowGraph::~DataFlowGraph()
 {
     delete impl_;
@@ -0,0 +1,271 @@
+#include "edit_journal.hpp"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace dt::df::editor
+{
+namespace
+{
+constexpr auto kFlushInterval = std::chrono::milliseconds{200};
+//! wake the flusher early if this much is pending
+constexpr std::size_t kFlushThreshold = 64 * 1024;
+//! size of the record payload incl. the op and its checksum
+constexpr std::size_t kRecordHeaderSize = 2 * sizeof(std::uint32_t);
+
+std::uint32_t checksum(std::span<const std::uint8_t> data)
+{
+    // FNV-1a
+    std::uint32_t hash = 2166136261u;
+    for (const auto byte : data)
+    {
+        hash ^= byte;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+class RecordParser
+{
+  public:
+    explicit RecordParser(std::span<const std::uint8_t> data)
+        : data_{data}
+    {}
+    template <typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, bytes(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+    std::span<const std::uint8_t> bytes(const std::size_t size)
+    {
+        if (size > data_.size())
+            throw std::out_of_range("journal record is too short");
+        auto result = data_.first(size);
+        data_ = data_.subspan(size);
+        return result;
+    }
+    std::span<const std::uint8_t> sizedBytes()
+    {
+        return bytes(read<std::uint32_t>());
+    }
+
+  private:
+    std::span<const std::uint8_t> data_;
+};
+} // namespace
+
+//! appends one record directly into the pending buffer. the buffer stays locked while the record is built.
+class EditJournal::RecordBuilder
+{
+  public:
+    RecordBuilder(EditJournal &journal, const JournalOp op)
+        : journal_{journal}
+        , lock_{journal.pending_mutex_}
+        , begin_{journal.pending_.size()}
+    {
+        journal_.pending_.resize(begin_ + kRecordHeaderSize);
+        put(op);
+    }
+    ~RecordBuilder()
+    {
+        auto &buffer = journal_.pending_;
+        const auto payload = std::span<const std::uint8_t>{buffer}.subspan(begin_ + kRecordHeaderSize);
+        const auto size = static_cast<std::uint32_t>(payload.size());
+        const auto sum = checksum(payload);
+        std::memcpy(buffer.data() + begin_, &size, sizeof(size));
+        std::memcpy(buffer.data() + begin_ + sizeof(size), &sum, sizeof(sum));
+        const bool request_flush = buffer.size() >= kFlushThreshold;
+        lock_.unlock();
+        if (request_flush)
+            journal_.flush_requested_.notify_one();
+    }
+    template <typename T>
+    RecordBuilder &put(const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto *begin = reinterpret_cast<const std::uint8_t *>(&value);
+        journal_.pending_.insert(journal_.pending_.end(), begin, begin + sizeof(T));
+        return *this;
+    }
+    RecordBuilder &putSized(std::span<const std::uint8_t> data)
+    {
+        put(static_cast<std::uint32_t>(data.size()));
+        journal_.pending_.insert(journal_.pending_.end(), data.begin(), data.end());
+        return *this;
+    }
+
+  private:
+    EditJournal &journal_;
+    std::unique_lock<std::mutex> lock_;
+    std::size_t begin_;
+};
+
+EditJournal::EditJournal(const std::filesystem::path &file, const bool truncate)
+    : out_{file, std::ios::binary | (truncate ? std::ios::trunc : std::ios::app)}
+{
+    if (!out_)
+        throw std::runtime_error("can't open the edit journal");
+    flusher_ = std::jthread{[this](std::stop_token stop_token) { flushLoop(stop_token); }};
+}
+
+EditJournal::~EditJournal()
+{
+    flusher_.request_stop();
+    flush_requested_.notify_one();
+    flusher_.join();
+    writePending();
+}
+
+void EditJournal::recordAddNode(
+    const NodeId id, const NodeKey &key, std::span<const std::uint8_t> state, const float x, const float y)
+{
+    RecordBuilder{*this, JournalOp::add_node}
+        .put(id)
+        .put(x)
+        .put(y)
+        .putSized(std::span{reinterpret_cast<const std::uint8_t *>(key.data()), key.size()})
+        .putSized(state);
+}
+
+void EditJournal::recordRemoveNode(const NodeId id)
+{
+    RecordBuilder{*this, JournalOp::remove_node}.put(id);
+}
+
+void EditJournal::recordAddEdge(const SlotId from, const SlotId to)
+{
+    RecordBuilder{*this, JournalOp::add_edge}.put(from).put(to);
+}
+
+void EditJournal::recordRemoveEdge(const SlotId from, const SlotId to)
+{
+    RecordBuilder{*this, JournalOp::remove_edge}.put(from).put(to);
+}
+
+void EditJournal::recordMoveNode(const NodeId id, const float x, const float y)
+{
+    RecordBuilder{*this, JournalOp::move_node}.put(id).put(x).put(y);
+}
+
+void EditJournal::recordRegisterSlot(const NodeId node_id, const SlotId slot_id, const SlotType type)
+{
+    RecordBuilder{*this, JournalOp::register_slot}.put(node_id).put(slot_id).put(static_cast<std::uint8_t>(type));
+}
+
+void EditJournal::recordUnregisterSlot(const NodeId node_id, const SlotId slot_id)
+{
+    RecordBuilder{*this, JournalOp::unregister_slot}.put(node_id).put(slot_id);
+}
+
+void EditJournal::flush()
+{
+    writePending();
+}
+
+void EditJournal::flushLoop(std::stop_token stop_token)
+{
+    while (!stop_token.stop_requested())
+    {
+        {
+            std::unique_lock lock{pending_mutex_};
+            flush_requested_.wait_for(
+                lock, stop_token, kFlushInterval, [this] { return pending_.size() >= kFlushThreshold; });
+        }
+        writePending();
+    }
+}
+
+void EditJournal::writePending()
+{
+    // the writer owns writing_, so the recording threads are only blocked for the buffer swap
+    std::lock_guard write_lock{write_mutex_};
+    {
+        std::lock_guard lock{pending_mutex_};
+        if (pending_.empty())
+            return;
+        std::swap(pending_, writing_);
+    }
+    out_.write(reinterpret_cast<const char *>(writing_.data()), static_cast<std::streamsize>(writing_.size()));
+    out_.flush();
+    writing_.clear();
+}
+
+std::size_t EditJournal::replay(const std::filesystem::path &file, const RecordVisitor &visitor)
+{
+    std::ifstream in{file, std::ios::binary};
+    if (!in)
+        return 0;
+    const std::vector<std::uint8_t> data{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+    std::size_t num_records = 0;
+    std::span<const std::uint8_t> remaining{data};
+    while (remaining.size() >= kRecordHeaderSize)
+    {
+        std::uint32_t size;
+        std::uint32_t sum;
+        std::memcpy(&size, remaining.data(), sizeof(size));
+        std::memcpy(&sum, remaining.data() + sizeof(size), sizeof(sum));
+        if (size > remaining.size() - kRecordHeaderSize)
+            break;
+        const auto payload = remaining.subspan(kRecordHeaderSize, size);
+        if (checksum(payload) != sum)
+            break;
+        remaining = remaining.subspan(kRecordHeaderSize + size);
+
+        Record record{};
+        try
+        {
+            RecordParser parser{payload};
+            record.op = parser.read<JournalOp>();
+            switch (record.op)
+            {
+            case JournalOp::add_node: {
+                record.node = parser.read<NodeId>();
+                record.x = parser.read<float>();
+                record.y = parser.read<float>();
+                const auto key = parser.sizedBytes();
+                record.key = std::string_view{reinterpret_cast<const char *>(key.data()), key.size()};
+                record.state = parser.sizedBytes();
+                break;
+            }
+            case JournalOp::remove_node:
+                record.node = parser.read<NodeId>();
+                break;
+            case JournalOp::add_edge:
+            case JournalOp::remove_edge:
+                record.from = parser.read<SlotId>();
+                record.to = parser.read<SlotId>();
+                break;
+            case JournalOp::move_node:
+                record.node = parser.read<NodeId>();
+                record.x = parser.read<float>();
+                record.y = parser.read<float>();
+                break;
+            case JournalOp::register_slot:
+                record.node = parser.read<NodeId>();
+                record.from = parser.read<SlotId>();
+                record.slot_type = static_cast<SlotType>(parser.read<std::uint8_t>());
+                break;
+            case JournalOp::unregister_slot:
+                record.node = parser.read<NodeId>();
+                record.from = parser.read<SlotId>();
+                break;
+            default:
+                continue;
+            }
+        }
+        catch (const std::out_of_range &)
+        {
+            // checksum matched but the record doesn't fit its op. written by an incompatible version.
+            break;
+        }
+        visitor(record);
+        num_records++;
+    }
+    return num_records;
+}
+} // namespace dt::df::editor
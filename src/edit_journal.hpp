@@ -0,0 +1,84 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <dt/df/core/types.hpp>
+
+namespace dt::df::editor
+{
+enum class JournalOp : std::uint8_t
+{
+    add_node = 1,
+    remove_node,
+    add_edge,
+    remove_edge,
+    move_node,
+    register_slot,
+    unregister_slot
+};
+
+//! append-only binary log of graph mutations which happened since the project file was written.
+//! Records are buffered and written in batches by a background thread. Every record carries its size and a checksum,
+//! so a record torn by a crash is detected and ends the replay.
+class EditJournal
+{
+  public:
+    struct Record
+    {
+        JournalOp op;
+        NodeId node;
+        SlotId from;        //! the slot for register_slot/unregister_slot
+        SlotId to;
+        SlotType slot_type;
+        float x; //! position for add_node/move_node
+        float y;
+        std::string_view key;
+        std::span<const std::uint8_t> state; //! msgpack of the node json
+    };
+    using RecordVisitor = std::function<void(const Record &record)>;
+
+  public:
+    //! opens the journal for appending. throws std::runtime_error if the file can't be opened.
+    EditJournal(const std::filesystem::path &file, const bool truncate);
+    EditJournal(const EditJournal &) = delete;
+    EditJournal &operator=(const EditJournal &) = delete;
+    //! writes all pending records
+    ~EditJournal();
+
+    //! x and y are the initial position in grid space
+    void recordAddNode(
+        const NodeId id, const NodeKey &key, std::span<const std::uint8_t> state, const float x, const float y);
+    void recordRemoveNode(const NodeId id);
+    void recordAddEdge(const SlotId from, const SlotId to);
+    void recordRemoveEdge(const SlotId from, const SlotId to);
+    void recordMoveNode(const NodeId id, const float x, const float y);
+    void recordRegisterSlot(const NodeId node_id, const SlotId slot_id, const SlotType type);
+    void recordUnregisterSlot(const NodeId node_id, const SlotId slot_id);
+    //! blocks until all records are handed to the operating system
+    void flush();
+
+    //! calls the visitor for every intact record in order. returns the number of replayed records.
+    static std::size_t replay(const std::filesystem::path &file, const RecordVisitor &visitor);
+
+  private:
+    class RecordBuilder;
+    void flushLoop(std::stop_token stop_token);
+    void writePending();
+
+  private:
+    std::ofstream out_;
+    std::mutex write_mutex_;
+    std::mutex pending_mutex_;
+    std::condition_variable_any flush_requested_;
+    std::vector<std::uint8_t> pending_;
+    std::vector<std::uint8_t> writing_;
+    std::jthread flusher_;
+};
+} // namespace dt::df::editor
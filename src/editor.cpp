@@ -4,6 +4,7 @@
 #include <imgui_internal.h>
 #include <imnodes.h>
 #include <spdlog/spdlog.h>
+#include "profiler.hpp"
 
 namespace dt::df::editor
 {
@@ -11,6 +12,8 @@ class Editor::Impl final
 {
   public:
     DataFlowGraph df_graph_;
+    //! reused by the deletion of the selected nodes
+    std::vector<NodeId> selected_nodes_;
 };
 
 Editor::Editor()
@@ -20,15 +23,29 @@ void Editor::init()
 {
     impl_->df_graph_.init();
 }
+void Editor::init(const std::filesystem::path &plugin_catalog)
+{
+    impl_->df_graph_.init(plugin_catalog);
+}
 void Editor::render()
 {
+    DTDF_PROFILE_GRAPH(impl_->df_graph_, TimingScope::editor_render);
+    {
+        DTDF_PROFILE_GRAPH(impl_->df_graph_, TimingScope::apply_commands);
+        impl_->df_graph_.applyPendingCommands();
+    }
+
     const auto begin = ImGui::GetCursorPos();
     const auto begin_screen = ImGui::GetCursorScreenPos();
-    imnodes::BeginNodeEditor();
-
-    impl_->df_graph_.render();
-
-    imnodes::EndNodeEditor();
+    {
+        DTDF_PROFILE_GRAPH(impl_->df_graph_, TimingScope::editor_graph);
+        imnodes::BeginNodeEditor();
+        impl_->df_graph_.render();
+        imnodes::EndNodeEditor();
+    }
+    DTDF_PROFILE_GRAPH(impl_->df_graph_, TimingScope::editor_interaction);
+    impl_->df_graph_.updateLinkDrag();
+    impl_->df_graph_.trackSelection();
     { // add pending connections
         int started_at_attribute_id;
         int ended_at_attribute_id;
@@ -49,13 +66,10 @@ void Editor::render()
         const int num_selected = imnodes::NumSelectedNodes();
         if (num_selected > 0 && ImGui::IsKeyReleased(ImGuiKey_Delete))
         {
-            static std::vector<int> selected_nodes;
+            auto &selected_nodes = impl_->selected_nodes_;
             selected_nodes.resize(static_cast<size_t>(num_selected));
             imnodes::GetSelectedNodes(selected_nodes.data());
-            for (const int node_id : selected_nodes)
-            {
-                impl_->df_graph_.removeNode(node_id);
-            }
+            impl_->df_graph_.removeNodes(selected_nodes);
         }
     }
 
@@ -81,11 +95,23 @@ void Editor::render()
     }
 }
 
+void Editor::setLevelOfDetailThreshold(const std::size_t max_detailed_nodes)
+{
+    impl_->df_graph_.setLevelOfDetailThreshold(max_detailed_nodes);
+}
+
 void Editor::renderNodeDisplayTree(const NodeDisplayDrawFnc &draw_fnc) const
 {
     impl_->df_graph_.renderNodeDisplayTree(draw_fnc);
 }
 
+std::vector<NodeSearchMatch> Editor::searchNodes(std::string_view query,
+                                                const std::size_t max_results,
+                                                const std::chrono::microseconds budget) const
+{
+    return impl_->df_graph_.searchNodes(query, max_results, budget);
+}
+
 DataFlowGraph &Editor::graph()
 {
     return impl_->df_graph_;
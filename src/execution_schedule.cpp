@@ -0,0 +1,118 @@
+#include "execution_schedule.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <dt/df/core/base_node.hpp>
+
+namespace dt::df::editor
+{
+namespace
+{
+//! how long the caller sleeps if the pool has nothing queued but the run isn't finished yet
+constexpr std::chrono::microseconds kHelpInterval{100};
+} // namespace
+
+struct ExecutionSchedule::RunState
+{
+    RunState(const TopologicalOrder &order, ThreadPool &pool, const NodeTask &task)
+        : order{order}
+        , pool{pool}
+        , task{task}
+        , nodes(order.numPositions(), nullptr)
+        , pending_inputs{std::make_unique<std::atomic<std::uint32_t>[]>(order.numPositions())}
+    {}
+
+    const TopologicalOrder &order;
+    ThreadPool &pool;
+    const NodeTask &task;
+    //! indexed by the position in the order
+    std::vector<core::BaseNode *> nodes;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> pending_inputs;
+    std::atomic<std::size_t> remaining{0};
+    std::promise<void> done;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+ExecutionSchedule::ExecutionSchedule(const TopologicalOrder &order)
+    : order_{order}
+{}
+
+std::size_t ExecutionSchedule::run(ThreadPool &pool, const NodeTask &task, const NodeLookup &lookup)
+{
+    // shared with the tasks, so that the last one can still touch the promise after the caller woke up
+    auto state = std::make_shared<RunState>(order_, pool, task);
+    std::vector<std::uint32_t> sources;
+    std::size_t num_nodes = 0;
+    for (std::uint32_t position = 0; position < order_.numPositions(); position++)
+    {
+        const auto id = order_.nodeAt(position);
+        if (id < 0)
+            continue;
+        num_nodes++;
+        state->nodes[position] = lookup(id);
+        const auto num_predecessors = static_cast<std::uint32_t>(order_.numPredecessors(id));
+        state->pending_inputs[position].store(num_predecessors, std::memory_order_relaxed);
+        if (num_predecessors == 0)
+            sources.emplace_back(position);
+    }
+    if (num_nodes == 0)
+        return 0;
+    state->remaining.store(num_nodes, std::memory_order_relaxed);
+
+    auto done = state->done.get_future();
+    for (const auto source : sources)
+        pool.post([state, source] { runNode(state, source); });
+    // blocking here would deadlock if the caller is a worker of the pool
+    while (done.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+    {
+        if (!pool.runPendingTask())
+            done.wait_for(kHelpInterval);
+    }
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+    return num_nodes;
+}
+
+void ExecutionSchedule::runNode(const std::shared_ptr<RunState> &state, std::uint32_t position)
+{
+    const auto &order = state->order;
+    while (true)
+    {
+        try
+        {
+            if (auto *node = state->nodes[position]; node)
+                state->task(*node);
+        }
+        catch (...)
+        {
+            std::lock_guard lock{state->error_mutex};
+            if (!state->error)
+                state->error = std::current_exception();
+        }
+
+        // the first ready successor runs on this thread, its inputs are still in the cache
+        std::int64_t next = -1;
+        order.forEachSuccessor(order.nodeAt(position), [&state, &order, &next](const NodeId successor_id) {
+            const auto successor = order.position(successor_id);
+            if (state->pending_inputs[successor].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            if (next < 0)
+                next = successor;
+            else
+                state->pool.post([state, successor] { runNode(state, successor); });
+        });
+        if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            state->done.set_value();
+            return;
+        }
+        if (next < 0)
+            return;
+        position = static_cast<std::uint32_t>(next);
+    }
+}
+} // namespace dt::df::editor
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <dt/df/core/types.hpp>
+#include "dt/df/editor/types.hpp"
+#include "thread_pool.hpp"
+#include "topological_order.hpp"
+
+namespace dt::df::editor
+{
+//! runs the nodes along the dependencies of a TopologicalOrder. The order is kept up to date with every edit and is
+//! acyclic, so there is nothing to compile or check before a run.
+class ExecutionSchedule
+{
+  public:
+    using NodeLookup = std::function<core::BaseNode *(const NodeId id)>;
+
+    explicit ExecutionSchedule(const TopologicalOrder &order);
+
+    //! runs task once for every node. a node starts after all nodes connected to its inputs are finished,
+    //! independent nodes run concurrently on the pool. blocks until the run is done, the calling thread runs queued
+    //! tasks of the pool meanwhile. the graph must not be edited during a run.
+    //! the first exception of a task is rethrown after the run. returns the number of executed nodes.
+    std::size_t run(ThreadPool &pool, const NodeTask &task, const NodeLookup &lookup);
+
+  private:
+    struct RunState;
+    static void runNode(const std::shared_ptr<RunState> &state, std::uint32_t position);
+
+  private:
+    const TopologicalOrder &order_;
+};
+} // namespace dt::df::editor
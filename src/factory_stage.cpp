@@ -0,0 +1,80 @@
+#include "factory_stage.hpp"
+
+namespace dt::df::editor
+{
+FactoryStage::FactoryStage(core::IGraphManager &graph)
+    : graph_{graph}
+{}
+
+void FactoryStage::registerNodeFactory(const NodeKey &key,
+                                       const std::string &node_display_name,
+                                       NodeFactory &&factory,
+                                       NodeDeserializationFactory &&deser_factory)
+{
+    node_factories_.emplace_back(StagedNodeFactory{key,
+                                                   node_display_name,
+                                                   std::forward<NodeFactory>(factory),
+                                                   std::forward<NodeDeserializationFactory>(deser_factory)});
+}
+
+void FactoryStage::registerSlotFactory(const SlotKey &key,
+                                       SlotFactory &&factory,
+                                       SlotDeserializationFactory &&deser_factory)
+{
+    slot_factories_.emplace_back(StagedSlotFactory{
+        key, std::forward<SlotFactory>(factory), std::forward<SlotDeserializationFactory>(deser_factory)});
+}
+
+const SlotFactory &FactoryStage::getSlotFactory(const SlotKey &key) const
+{
+    return graph_.getSlotFactory(key);
+}
+
+const SlotDeserializationFactory &FactoryStage::getSlotDeserFactory(const SlotKey &key) const
+{
+    return graph_.getSlotDeserFactory(key);
+}
+
+NodeId FactoryStage::generateNodeId()
+{
+    return graph_.generateNodeId();
+}
+
+SlotId FactoryStage::generateSlotId()
+{
+    return graph_.generateSlotId();
+}
+
+bool FactoryStage::registerSlot(const NodeId node_id, const SlotId slot_id, const SlotType type)
+{
+    return graph_.registerSlot(node_id, slot_id, type);
+}
+
+bool FactoryStage::unregisterSlot(const NodeId node_id, const SlotId slot_id)
+{
+    return graph_.unregisterSlot(node_id, slot_id);
+}
+
+void FactoryStage::commitSlotFactories()
+{
+    for (auto &staged : slot_factories_)
+        graph_.registerSlotFactory(staged.key, std::move(staged.factory), std::move(staged.deser_factory));
+}
+
+void FactoryStage::commitNodeFactories()
+{
+    for (auto &staged : node_factories_)
+        graph_.registerNodeFactory(
+            staged.key, staged.display_name, std::move(staged.factory), std::move(staged.deser_factory));
+}
+
+CatalogPlugin FactoryStage::describe(const std::string &plugin_name) const
+{
+    CatalogPlugin plugin{plugin_name, {}, {}, {}};
+    for (const auto &staged : slot_factories_)
+        plugin.slot_keys.emplace_back(staged.key);
+    for (const auto &staged : node_factories_)
+        plugin.nodes.emplace_back(CatalogNode{staged.key, staged.display_name});
+    return plugin;
+}
+} // namespace dt::df::editor
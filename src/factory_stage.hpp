@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <dt/df/core/graph_manager.hpp>
+#include "plugin_catalog.hpp"
+
+namespace dt::df::editor
+{
+struct StagedNodeFactory
+{
+    NodeKey key;
+    std::string display_name;
+    NodeFactory factory;
+    NodeDeserializationFactory deser_factory;
+};
+struct StagedSlotFactory
+{
+    SlotKey key;
+    SlotFactory factory;
+    SlotDeserializationFactory deser_factory;
+};
+
+//! collects the factory registrations of one plugin, so plugins can register concurrently.
+//! Everything except the registration is forwarded to the graph.
+class FactoryStage final : public core::IGraphManager
+{
+  public:
+    explicit FactoryStage(core::IGraphManager &graph);
+    void registerNodeFactory(const NodeKey &key,
+                             const std::string &node_display_name,
+                             NodeFactory &&factory,
+                             NodeDeserializationFactory &&deser_factory) override;
+    void registerSlotFactory(const SlotKey &key,
+                             SlotFactory &&factory,
+                             SlotDeserializationFactory &&deser_factory) override;
+    const SlotFactory &getSlotFactory(const SlotKey &key) const override;
+    const SlotDeserializationFactory &getSlotDeserFactory(const SlotKey &key) const override;
+
+    NodeId generateNodeId() override;
+    SlotId generateSlotId() override;
+    bool registerSlot(const NodeId node_id, const SlotId slot_id, const SlotType type) override;
+    bool unregisterSlot(const NodeId node_id, const SlotId slot_id) override;
+
+    //! moves the staged slot factories into the graph in registration order. only the keys are kept.
+    void commitSlotFactories();
+    //! moves the staged node factories into the graph in registration order. only the keys are kept.
+    void commitNodeFactories();
+    CatalogPlugin describe(const std::string &plugin_name) const;
+
+  private:
+    core::IGraphManager &graph_;
+    std::vector<StagedNodeFactory> node_factories_;
+    std::vector<StagedSlotFactory> slot_factories_;
+};
+} // namespace dt::df::editor
@@ -1,7 +1,11 @@
 #include "graph_impl.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
 #include <fstream>
+#include <limits>
+#include <optional>
 
 #include <Corrade/Containers/PointerStl.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -9,37 +13,228 @@
 #include <dt/df/core/base_node.hpp>
 #include <dt/df/core/base_slot.hpp>
 #include <dt/df/plugin/plugin.hpp>
+#include <imgui.h>
 #include <imnodes.h>
 #include <nlohmann/json.hpp>
+#include "atomic_file.hpp"
+#include "edit_journal.hpp"
+#include "factory_stage.hpp"
+#include "graph_json_reader.hpp"
+#include "plugin_catalog.hpp"
+#include "profiler.hpp"
+#include "graph_snapshot.hpp"
 
 using namespace Corrade;
 namespace dt::df::editor
 {
+namespace
+{
+//! compaction only pays off if there are enough dead vertices to get rid of
+constexpr std::size_t kMinCompactionVertices = 1024;
+//! marks node types that are not provided by a lazy plugin
+constexpr std::size_t kNoLazyPlugin = std::numeric_limits<std::size_t>::max();
+//! nodes slightly outside of the canvas are still rendered to avoid popping at the borders
+constexpr float kCullingMargin = 128.f;
+//! level of detail is opt-in, see setLevelOfDetailThreshold
+constexpr std::size_t kDefaultMaxDetailedNodes = 0;
+//! proxies are only replaced by detailed nodes again once the visible nodes dropped to this share of the threshold.
+//! Otherwise the changing node sizes could flip the level of detail back and forth every frame.
+constexpr std::size_t kDetailHysteresisPercent = 75;
+constexpr std::size_t kCommandQueueCapacity = 4096;
+constexpr std::size_t kOverlayNodes = 16;
+constexpr float kProxyPinWidth = 96.f;
+constexpr ImU32 kCompatiblePinColor = IM_COL32(80, 200, 120, 255);
+//! id of the prototype slots of buildSlotCompatibility. they are never registered.
+constexpr SlotId kPrototypeSlotId = -1;
+//! added to every node object of a json graph file
+constexpr const char *kJsonPositionKey = "editor_position";
+
+bool isJsonFile(const std::filesystem::path &file)
+{
+    return file.extension() == ".json";
+}
+
+std::filesystem::path journalFile(const std::filesystem::path &project_file)
+{
+    auto file = project_file;
+    file += ".journal";
+    return file;
+}
+} // namespace
 
-GraphImpl::GraphImpl()
+GraphImpl::GraphImpl(const RuntimeMode mode)
+    : headless_{mode == RuntimeMode::headless}
+    , max_detailed_nodes_{kDefaultMaxDetailedNodes}
+    , commands_{kCommandQueueCapacity}
 {}
 
 void GraphImpl::init()
 {
+    activatePlugins(manager_.pluginList(), nullptr);
+    buildSlotCompatibility();
+}
+
+void GraphImpl::init(const std::filesystem::path &catalog_file)
+{
+    const auto plugin_names = manager_.pluginList();
+    auto catalog = PluginCatalog::load(catalog_file);
+    bool catalog_changed = catalog.retain(plugin_names) > 0;
+
+    // plugins are usually upgraded by overwriting their files in place, so every file is compared on its own
+    std::vector<std::string> uncataloged_plugins;
+    for (const auto &plugin_name : plugin_names)
+    {
+        const auto *plugin = catalog.find(plugin_name);
+        if (plugin && plugin->files == PluginCatalog::pluginFiles(manager_.pluginDirectory(), plugin_name))
+            addLazyPlugin(*plugin);
+        else
+            uncataloged_plugins.emplace_back(plugin_name);
+    }
+    if (!uncataloged_plugins.empty())
+    {
+        activatePlugins(uncataloged_plugins, &catalog);
+        catalog_changed = true;
+    }
+    if (catalog_changed)
+        catalog.save(catalog_file);
+    buildSlotCompatibility();
+}
+
+void GraphImpl::activatePlugins(const std::vector<std::string> &plugin_names, PluginCatalog *catalog)
+{
+    // loading stays on this thread. Managers aren't thread safe and even separate ones share Corrade's plugin
+    // registry and the process wide dlopen and dependency state. Only the factory registration runs in parallel.
+    std::vector<LoadedPlugin> plugins;
+    for (const auto &plugin_name : plugin_names)
+    {
+        auto plugin = loadPlugin(plugin_name);
+        if (plugin.instance)
+            plugins.emplace_back(std::move(plugin));
+    }
 
-    for (const auto &plugin_name : manager_.pluginList())
+    // the contexts are only current on this thread. headless there are no contexts to hand over.
+    if (!headless_)
     {
-        if (!(manager_.load(plugin_name) & PluginManager::LoadState::Loaded))
+        for (auto &plugin : plugins)
         {
-            Utility::Error{} << "The requested plugin" << plugin_name.c_str() << "cannot be loaded.";
-            continue;
+            plugin.instance->setup(
+                Magnum::GL::Context::current(), ImGui::GetCurrentContext(), imnodes::GetCurrentContext());
         }
-        std::unique_ptr<plugin::Plugin> plugin = std::move(manager_.instantiate(plugin_name));
-
-        plugin->setup(Magnum::GL::Context::current(), ImGui::GetCurrentContext(), imnodes::GetCurrentContext());
-        plugin->registerSlotFactories(*this);
-        loaded_plugins_.emplace_back(std::move(plugin));
     }
+
+    std::vector<FactoryStage> stages;
+    stages.reserve(plugins.size());
+    for (std::size_t i = 0; i < plugins.size(); i++)
+        stages.emplace_back(*this);
+
+    forEachParallel(plugins.size(),
+                    [&stages, &plugins](const std::size_t i) { plugins[i].instance->registerSlotFactories(stages[i]); });
+    for (auto &stage : stages)
+        stage.commitSlotFactories();
+
     // load after all slots have been registerd
-    for (const auto &plugin : loaded_plugins_)
+    forEachParallel(plugins.size(),
+                    [&stages, &plugins](const std::size_t i) { plugins[i].instance->registerNodeFactories(stages[i]); });
+    for (auto &stage : stages)
+        stage.commitNodeFactories();
+
+    for (std::size_t i = 0; i < plugins.size(); i++)
+    {
+        if (catalog)
+        {
+            auto plugin = stages[i].describe(plugins[i].name);
+            plugin.files = PluginCatalog::pluginFiles(manager_.pluginDirectory(), plugins[i].name);
+            catalog->set(std::move(plugin));
+        }
+        loaded_plugins_.emplace_back(std::move(plugins[i]));
+    }
+}
+
+GraphImpl::LoadedPlugin GraphImpl::loadPlugin(const std::string &plugin_name)
+{
+    LoadedPlugin plugin{plugin_name, nullptr};
+    if (!(manager_.load(plugin_name) & PluginManager::LoadState::Loaded))
     {
-        plugin->registerNodeFactories(*this);
+        Utility::Error{} << "The requested plugin" << plugin_name.c_str() << "cannot be loaded.";
+        return plugin;
     }
+    plugin.instance = std::move(manager_.instantiate(plugin_name));
+    return plugin;
+}
+
+void GraphImpl::forEachParallel(const std::size_t count, const std::function<void(const std::size_t index)> &fnc)
+{
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+        tasks.emplace_back(workerPool().submit([&fnc, i] { fnc(i); }));
+    // every task has to be finished before an exception leaves this function. they reference the caller's state.
+    for (auto &task : tasks)
+        task.wait();
+    for (auto &task : tasks)
+        task.get();
+}
+
+void GraphImpl::addLazyPlugin(const CatalogPlugin &plugin)
+{
+    const auto plugin_index = lazy_plugins_.size();
+    lazy_plugins_.emplace_back(LazyPlugin{plugin.name, !plugin.slot_keys.empty(), false});
+    for (const auto &node : plugin.nodes)
+    {
+        const auto key_id = internNodeKey(node.key);
+        addNodeDisplayName(key_id, node.display_name);
+        if (lazy_node_plugins_[key_id] == kNoLazyPlugin)
+            lazy_node_plugins_[key_id] = plugin_index;
+    }
+}
+
+void GraphImpl::activateLazyPlugins(const NodeKey &key)
+{
+    if (lazy_plugins_.empty())
+        return;
+
+    std::vector<std::string> plugin_names;
+    const auto activate = [&plugin_names](LazyPlugin &plugin) {
+        if (plugin.active)
+            return;
+        plugin.active = true;
+        plugin_names.emplace_back(plugin.name);
+    };
+    // any node might use the slots of any plugin. so all slot factories are registered with the first node.
+    if (!lazy_slot_providers_active_)
+    {
+        lazy_slot_providers_active_ = true;
+        for (auto &plugin : lazy_plugins_)
+        {
+            if (plugin.provides_slots)
+                activate(plugin);
+        }
+    }
+    if (const auto key_id = node_keys_.find(key); key_id != kInvalidKeyId && !node_factories_[key_id])
+    {
+        if (const auto plugin_index = lazy_node_plugins_[key_id]; plugin_index != kNoLazyPlugin)
+            activate(lazy_plugins_[plugin_index]);
+    }
+    if (!plugin_names.empty())
+    {
+        activatePlugins(plugin_names, nullptr);
+        if (slot_keys_.size() != slot_compatibility_.keyCount())
+            buildSlotCompatibility();
+    }
+}
+
+bool GraphImpl::needsLazyActivation(const NodeKey &key) const
+{
+    if (lazy_plugins_.empty())
+        return false;
+    const auto inactive_slot_provider = [](const LazyPlugin &plugin) { return plugin.provides_slots && !plugin.active; };
+    if (!lazy_slot_providers_active_ && std::any_of(lazy_plugins_.begin(), lazy_plugins_.end(), inactive_slot_provider))
+        return true;
+    const auto key_id = node_keys_.find(key);
+    if (key_id == kInvalidKeyId || node_factories_[key_id])
+        return false;
+    const auto plugin_index = lazy_node_plugins_[key_id];
+    return plugin_index != kNoLazyPlugin && !lazy_plugins_[plugin_index].active;
 }
 
 NodeId GraphImpl::generateNodeId()
@@ -48,6 +243,8 @@ NodeId GraphImpl::generateNodeId()
 }
 SlotId GraphImpl::generateSlotId()
 {
+    if (creating_slot_prototypes_)
+        return kPrototypeSlotId;
     return vertex_id_counter_++;
 }
 bool GraphImpl::registerSlot(const NodeId node_id, const SlotId slot_id, const SlotType type)
@@ -64,6 +261,8 @@ bool GraphImpl::registerSlot(const NodeId node_id, const SlotId slot_id, const S
     {
         const auto node_vert = findVertexById(node->id());
         addSlot(node, node_vert, slot, type);
+        if (journal_)
+            journal_->recordRegisterSlot(node_id, slot_id, type);
         return true;
     }
     catch (const std::out_of_range &)
@@ -81,6 +280,9 @@ bool GraphImpl::unregisterSlot(const NodeId node_id, const SlotId slot_id)
     if (!node->inputs(slot_id) && !node->outputs(slot_id))
         return false;
     removeSlot(slot_id);
+    compactIfNeeded();
+    if (journal_)
+        journal_->recordUnregisterSlot(node_id, slot_id);
     return true;
 }
 
@@ -89,62 +291,161 @@ void GraphImpl::registerNodeFactory(const NodeKey &key,
                                     NodeFactory &&factory,
                                     NodeDeserializationFactory &&deser_factory)
 {
-    node_factories_.emplace(key, std::forward<NodeFactory>(factory));
-    node_deser_factories_.emplace(key, std::forward<NodeDeserializationFactory>(deser_factory));
+    const auto key_id = internNodeKey(key);
+    // the first registration of a key wins
+    if (!node_factories_[key_id])
+        node_factories_[key_id] = std::forward<NodeFactory>(factory);
+    if (!node_deser_factories_[key_id])
+        node_deser_factories_[key_id] = std::forward<NodeDeserializationFactory>(deser_factory);
+
+    addNodeDisplayName(key_id, node_display_name);
+}
+
+void GraphImpl::addNodeDisplayName(const KeyId key_id, const std::string &node_display_name)
+{
+    node_display_names_.addNode(key_id, node_display_name);
+    node_search_index_.add(key_id, node_keys_.key(key_id), node_display_name);
+    const auto title_begin = node_display_name.find_last_of('/');
+    node_titles_[key_id] =
+        title_begin == std::string::npos ? node_display_name : node_display_name.substr(title_begin + 1);
+}
+
+KeyId GraphImpl::internNodeKey(const NodeKey &key)
+{
+    const auto key_id = node_keys_.intern(key);
+    if (key_id >= node_factories_.size())
+    {
+        node_factories_.resize(key_id + 1);
+        node_deser_factories_.resize(key_id + 1);
+        node_titles_.resize(key_id + 1);
+        lazy_node_plugins_.resize(key_id + 1, kNoLazyPlugin);
+    }
+    return key_id;
+}
+
+void GraphImpl::buildSlotCompatibility()
+{
+    // canConnectTo only depends on the key of the slot, so one prototype per key answers for all slots
+    // only called on the render thread while no nodes are created concurrently, so no real slot gets the sentinel id
+    creating_slot_prototypes_ = true;
+    std::vector<SlotPtr> prototypes(slot_keys_.size());
+    for (KeyId key_id = 0; key_id < prototypes.size(); key_id++)
+    {
+        if (!slot_factories_[key_id])
+            continue;
+        try
+        {
+            prototypes[key_id] = slot_factories_[key_id](*this, SlotType::output, "", -1);
+        }
+        catch (const std::exception &ex)
+        {
+            Utility::Error{} << "Could not create a prototype of slot" << slot_keys_.key(key_id).c_str() << ":"
+                             << ex.what();
+        }
+    }
+    creating_slot_prototypes_ = false;
+    slot_compatibility_.build(prototypes.size(), [this, &prototypes](const KeyId from, const KeyId to) {
+        return prototypes[from] && prototypes[from]->canConnectTo(slot_keys_.key(to));
+    });
+}
 
-    node_display_names_.addNode(key, node_display_name);
+KeyId GraphImpl::slotKeyId(const SlotId id) const
+{
+    return static_cast<std::size_t>(id) < slot_key_ids_.size() ? slot_key_ids_[id] : kInvalidKeyId;
+}
+
+bool GraphImpl::canConnectSlots(const SlotId from, const SlotId to) const
+{
+    const auto from_key = slotKeyId(from);
+    const auto to_key = slotKeyId(to);
+    if (from_key < slot_compatibility_.keyCount() && to_key < slot_compatibility_.keyCount())
+        return slot_compatibility_.canConnect(from_key, to_key);
+    const auto output_slot = findSlotById(from);
+    const auto input_slot = findSlotById(to);
+    return output_slot && input_slot && output_slot->canConnectTo(input_slot->key());
+}
+
+KeyId GraphImpl::internSlotKey(const SlotKey &key)
+{
+    const auto key_id = slot_keys_.intern(key);
+    if (key_id >= slot_factories_.size())
+    {
+        slot_factories_.resize(key_id + 1);
+        slot_deser_factories_.resize(key_id + 1);
+    }
+    return key_id;
 }
 
 void GraphImpl::registerSlotFactory(const SlotKey &key,
                                     SlotFactory &&factory,
                                     SlotDeserializationFactory &&deser_factory)
 {
-    slot_factories_.emplace(key, std::forward<SlotFactory>(factory));
-    slot_deser_factories_.emplace(key, std::forward<SlotDeserializationFactory>(deser_factory));
+    const auto key_id = internSlotKey(key);
+    if (!slot_factories_[key_id])
+        slot_factories_[key_id] = std::forward<SlotFactory>(factory);
+    if (!slot_deser_factories_[key_id])
+        slot_deser_factories_[key_id] = std::forward<SlotDeserializationFactory>(deser_factory);
 }
 
 const NodeFactory &GraphImpl::getNodeFactory(const NodeKey &key) const
 {
-    auto factory_fnc_it = node_factories_.find(key);
-    if (factory_fnc_it == node_factories_.end())
+    const auto key_id = node_keys_.find(key);
+    if (key_id == kInvalidKeyId || !node_factories_[key_id])
         throw std::out_of_range("node factory not found");
-    return factory_fnc_it->second;
+    return node_factories_[key_id];
 }
 
 const NodeDeserializationFactory &GraphImpl::getNodeDeserializationFactory(const NodeKey &key) const
 {
-    auto factory_fnc_it = node_deser_factories_.find(key);
-    if (factory_fnc_it == node_deser_factories_.end())
+    const auto key_id = node_keys_.find(key);
+    if (key_id == kInvalidKeyId || !node_deser_factories_[key_id])
         throw std::out_of_range("node deserialization factory not found");
-    return factory_fnc_it->second;
+    return node_deser_factories_[key_id];
 }
 
 const SlotFactory &GraphImpl::getSlotFactory(const SlotKey &key) const
 {
-    auto factory_fnc_it = slot_factories_.find(key);
-    if (factory_fnc_it == slot_factories_.end())
+    const auto key_id = slot_keys_.find(key);
+    if (key_id == kInvalidKeyId || !slot_factories_[key_id])
         throw std::out_of_range("slot factory not found");
-    return factory_fnc_it->second;
+    return slot_factories_[key_id];
 }
 const SlotDeserializationFactory &GraphImpl::getSlotDeserFactory(const SlotKey &key) const
 {
-    auto factory_fnc_it = slot_deser_factories_.find(key);
-    if (factory_fnc_it == slot_deser_factories_.end())
+    const auto key_id = slot_keys_.find(key);
+    if (key_id == kInvalidKeyId || !slot_deser_factories_[key_id])
         throw std::out_of_range("slot deserialization factory not found");
-    return factory_fnc_it->second;
+    return slot_deser_factories_[key_id];
 }
 
-void GraphImpl::createNode(const NodeKey &key, int preferred_x, int preferred_y, bool screen_space)
+NodeId GraphImpl::createNode(const NodeKey &key, int preferred_x, int preferred_y, bool screen_space)
 {
+    activateLazyPlugins(key);
     auto node = getNodeFactory(key)(*this);
     node->init(*this);
     addNode(node);
-    node->setPosition(preferred_x, preferred_y, screen_space);
+    if (headless_)
+        placeNode(node, static_cast<float>(preferred_x), static_cast<float>(preferred_y));
+    else
+        node->setPosition(preferred_x, preferred_y, screen_space);
+    if (journal_)
+    {
+        const auto position = nodePosition(node->id());
+        journal_->recordAddNode(
+            node->id(), key, nlohmann::json::to_msgpack(nlohmann::json(*node)), position.x, position.y);
+    }
+    return node->id();
 }
 
 void GraphImpl::addNode(const NodePtr &node)
 {
     nodes_.emplace(node->id(), node);
+    if (static_cast<std::size_t>(node->id()) >= node_key_ids_.size())
+        node_key_ids_.resize(static_cast<std::size_t>(node->id()) + 1, kInvalidKeyId);
+    node_key_ids_[node->id()] = node_keys_.find(node->key());
+    if (!headless_)
+        unplaced_nodes_.emplace_back(node->id());
+    topological_order_.addNode(node->id());
     const auto node_vertex = addVertex(0, node->id(), -1, VertexType::node);
 
     for (auto &slot : node->inputs())
@@ -156,156 +457,369 @@ void GraphImpl::addNode(const NodePtr &node)
 
 void GraphImpl::removeNode(const NodeId id)
 {
-    auto node_it = nodes_.find(id);
-    if (node_it == nodes_.end())
+    removeNodes(std::span{&id, 1});
+}
+
+void GraphImpl::removeNodes(std::span<const NodeId> ids)
+{
+    DTDF_PROFILE_SCOPE(profiler_, TimingScope::remove_nodes);
+    std::vector<NodeId> node_ids(ids.begin(), ids.end());
+    std::sort(node_ids.begin(), node_ids.end());
+    node_ids.erase(std::unique(node_ids.begin(), node_ids.end()), node_ids.end());
+
+    // collect the vertices of all nodes and their slots first
+    std::vector<VertexDesc> vertices;
+    const auto unindexVertex = [this, &vertices](const int vertex_id) {
+        if (auto vertex_it = vertex_index_.find(vertex_id); vertex_it != vertex_index_.end())
+        {
+            vertices.emplace_back(vertex_it->second);
+            vertex_index_.erase(vertex_it);
+        }
+    };
+    const auto removed_end = std::remove_if(node_ids.begin(), node_ids.end(), [this, &unindexVertex](const NodeId id) {
+        const auto node_it = nodes_.find(id);
+        if (node_it == nodes_.end())
+            return true;
+        unindexVertex(id);
+        for (const auto &slot : node_it->second->inputs())
+            unindexVertex(slot.second->id());
+        for (const auto &slot : node_it->second->outputs())
+            unindexVertex(slot.second->id());
+        return false;
+    });
+    node_ids.erase(removed_end, node_ids.end());
+    if (node_ids.empty())
         return;
 
-    try
+    // links between two removed nodes are visited from both ends. eraseLink skips the second visit.
+    const auto unlink = [this](const EdgeDesc edge) {
+        graph_.edge(edge).connection.connection.disconnect();
+        eraseLink(graph_.edge(edge).id);
+    };
+    for (const auto vertex : vertices)
     {
-        // remove node
-        auto node_vertex = findVertexById(id);
-        boost::clear_vertex(node_vertex, graph_);
+        if (graph_.type(vertex) == VertexType::input)
+            graph_.forEachInEdge(vertex, unlink);
+        else if (graph_.type(vertex) == VertexType::output)
+            graph_.forEachOutEdge(vertex, unlink);
     }
-    catch (const std::out_of_range &)
+    graph_.clearVertices(vertices);
+    for (const auto vertex : vertices)
+        releaseVertex(vertex);
+
+    for (const auto id : node_ids)
     {
-        //! \todo add logger
+        nodes_.erase(id);
+        spatial_grid_.remove(id);
+        topological_order_.removeNode(id);
+#ifdef DTDFEDITOR_PROFILING
+        profiler_.removeNode(id);
+#endif
+        if (journal_)
+            journal_->recordRemoveNode(id);
     }
-
-    removeNodeSlots(node_it->second->inputs());
-    removeNodeSlots(node_it->second->outputs());
-
-    nodes_.erase(node_it);
+    compactIfNeeded();
 }
 
 VertexDesc GraphImpl::addSlot(const NodePtr &node, const VertexDesc node_vert, const SlotPtr &slot, const SlotType type)
 {
+    if (static_cast<std::size_t>(slot->id()) >= slot_key_ids_.size())
+        slot_key_ids_.resize(static_cast<std::size_t>(slot->id()) + 1, kInvalidKeyId);
+    slot_key_ids_[slot->id()] = slot_keys_.find(slot->key());
     return addVertex(
         node_vert, slot->id(), node->id(), type == SlotType::input ? VertexType::input : VertexType::output);
 }
 
 void GraphImpl::removeSlot(const SlotId slot_id)
 {
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end, next;
-    boost::tie(vi, vi_end) = boost::vertices(graph_);
-    for (next = vi; vi != vi_end; vi = next)
+    auto vertex_it = vertex_index_.find(slot_id);
+    if (vertex_it == vertex_index_.end())
+        return;
+    const auto slot_vertex = vertex_it->second;
+
+    const auto disconnect = [this](const EdgeDesc edge) { graph_.edge(edge).connection.connection.disconnect(); };
+    if (graph_.type(slot_vertex) == VertexType::input)
+        graph_.forEachInEdge(slot_vertex, disconnect);
+    else if (graph_.type(slot_vertex) == VertexType::output)
+        graph_.forEachOutEdge(slot_vertex, disconnect);
+    unindexEdges(slot_vertex);
+    graph_.clearVertex(slot_vertex);
+    vertex_index_.erase(vertex_it);
+    releaseVertex(slot_vertex);
+}
+
+void GraphImpl::unindexEdges(const VertexDesc vertex)
+{
+    const auto erase = [this](const EdgeDesc edge) { eraseLink(graph_.edge(edge).id); };
+    graph_.forEachOutEdge(vertex, erase);
+    graph_.forEachInEdge(vertex, erase);
+}
+
+void GraphImpl::eraseLink(const EdgeId id)
+{
+    auto edge_it = edge_index_.find(id);
+    if (edge_it == edge_index_.end())
+        return;
+    // swap with the last link to keep the list dense
+    const auto link_pos = edge_it->second.link_pos;
+    topological_order_.removeDependency(links_[link_pos].from_node, links_[link_pos].to_node);
+    if (link_pos != links_.size() - 1)
     {
-        ++next;
-        if (graph_[*vi].id == slot_id)
-        {
-            if (graph_[*vi].type == VertexType::input)
-            {
-                const auto in_edges = boost::in_edges(*vi, graph_);
-                for (auto it = in_edges.first; it != in_edges.second; it++)
-                {
-                    const auto &edge_prop = boost::get(EdgeInfo_t(), graph_, *it);
-                    edge_prop.connection->connection.disconnect();
-                }
-            }
-            else if (graph_[*vi].type == VertexType::output)
-            {
-                const auto out_edges = boost::out_edges(*vi, graph_);
-                for (auto it = out_edges.first; it != out_edges.second; it++)
-                {
-                    const auto &edge_prop = boost::get(EdgeInfo_t(), graph_, *it);
-                    edge_prop.connection->connection.disconnect();
-                }
-            }
-            boost::clear_vertex(*vi, graph_);
-        }
+        links_[link_pos] = links_.back();
+        edge_index_.at(links_[link_pos].id).link_pos = link_pos;
     }
+    links_.pop_back();
+    edge_index_.erase(edge_it);
 }
 
 VertexDesc GraphImpl::addVertex(const VertexDesc node_desc, const int id, const int parent_id, VertexType type)
 {
-    VertexInfo info{id, parent_id, type};
-    const auto vertex_desc = boost::add_vertex(std::move(info), graph_);
+    const VertexInfo info{id, parent_id, type};
+    VertexDesc vertex_desc;
+    if (free_vertices_.empty())
+        vertex_desc = graph_.addVertex(info);
+    else
+    {
+        vertex_desc = free_vertices_.back();
+        free_vertices_.pop_back();
+        graph_.setVertex(vertex_desc, info);
+    }
+    vertex_index_.insert_or_assign(id, vertex_desc);
     if (type != VertexType::node)
     {
-        EdgeInfo edge_info{link_id_counter_++, nullptr};
+        EdgeInfo edge_info{link_id_counter_++, RefCon{}};
         if (type == VertexType::input)
-            boost::add_edge(vertex_desc, node_desc, std::move(edge_info), graph_);
+            graph_.addEdge(vertex_desc, node_desc, std::move(edge_info));
         else if (type == VertexType::output)
-            boost::add_edge(node_desc, vertex_desc, std::move(edge_info), graph_);
+            graph_.addEdge(node_desc, vertex_desc, std::move(edge_info));
     }
     return vertex_desc;
 }
 
-void GraphImpl::addEdge(const VertexDesc from, const VertexDesc to)
+void GraphImpl::releaseVertex(const VertexDesc vertex)
 {
-    assert(("from needs to be an output", graph_[from].type == VertexType::output));
-    assert(("to needs to be an input", graph_[to].type == VertexType::input));
-    assert(("from parent isn't set", graph_[from].parent_id >= 0));
-    assert(("to parent isn't set", graph_[to].parent_id >= 0));
+    assert(("vertex needs to be cleared before release", graph_.degree(vertex) == 0));
+    graph_.setVertex(vertex, VertexInfo{-1, -1, VertexType::unused});
+    free_vertices_.emplace_back(vertex);
+}
 
-    auto from_node = nodes_.find(graph_[from].parent_id);
-    if (from_node == nodes_.end())
-        assert("from parent not set correctly");
+void GraphImpl::compactIfNeeded()
+{
+    const auto dead_vertices = free_vertices_.size();
+    const auto live_vertices = graph_.numVertices() - dead_vertices;
+    if (dead_vertices >= kMinCompactionVertices && dead_vertices > live_vertices)
+        compact();
+}
 
-    auto to_node = nodes_.find(graph_[to].parent_id);
-    if (to_node == nodes_.end())
-        assert("to parent not set correctly");
+void GraphImpl::compact()
+{
+    // the live vertices move down, so the vertex index is rebuilt. edge descriptors stay valid.
+    graph_.compactVertices();
+    free_vertices_.clear();
+    vertex_index_.clear();
+    for (VertexDesc vertex = 0; vertex < graph_.numVertices(); vertex++)
+        vertex_index_.emplace(graph_.id(vertex), vertex);
+}
 
-    auto output_slot = from_node->second->outputs(graph_[from].id);
-    if (!output_slot)
-        assert("output is null. so id isn't correctly set");
+EdgeId GraphImpl::addEdge(const VertexDesc from, const VertexDesc to)
+{
+    DTDF_PROFILE_SCOPE(profiler_, TimingScope::add_edge);
+    // the ids may come from a worker thread or a file, so they are checked in release builds as well
+    if (graph_.type(from) != VertexType::output)
+        throw std::invalid_argument("the link has to start at an output slot");
+    if (graph_.type(to) != VertexType::input)
+        throw std::invalid_argument("the link has to end at an input slot");
 
-    auto input_slot = to_node->second->inputs(graph_[to].id);
-    if (!input_slot)
-        assert("input is null. so id isn't correctly set");
+    auto from_node = nodes_.find(graph_.parentId(from));
+    auto to_node = nodes_.find(graph_.parentId(to));
+    if (from_node == nodes_.end() || to_node == nodes_.end())
+        throw std::invalid_argument("the node of a slot doesn't exist");
 
-    if (!output_slot->canConnectTo(input_slot->key()))
-        return;
+    auto output_slot = from_node->second->outputs(graph_.id(from));
+    auto input_slot = to_node->second->inputs(graph_.id(to));
+    if (!output_slot || !input_slot)
+        throw std::invalid_argument("the node doesn't own the slot");
 
-    auto connection = output_slot->connectTo(input_slot);
+    if (!canConnectSlots(graph_.id(from), graph_.id(to)))
+        return -1;
+    // the caller gets -1, logging here would flood the output of tools which try many links
+    if (!topological_order_.addDependency(from_node->first, to_node->first))
+        return -1;
 
-    const EdgeInfo egde_prop{link_id_counter_++, std::make_shared<RefCon>(std::move(connection))};
-    boost::add_edge(from, to, std::move(egde_prop), graph_);
+    // the dependency goes in first since it detects the cycles. it must not outlive a link which wasn't made.
+    EdgeId edge_id = -1;
+    try
+    {
+        auto connection = output_slot->connectTo(input_slot);
+        if (!connection.connected())
+        {
+            topological_order_.removeDependency(from_node->first, to_node->first);
+            return -1;
+        }
+        edge_id = link_id_counter_++;
+        const auto edge_desc = graph_.addEdge(from, to, EdgeInfo{edge_id, RefCon{std::move(connection)}});
+        edge_index_.emplace(edge_id, LinkRef{edge_desc, links_.size()});
+        links_.emplace_back(LinkInfo{edge_id, graph_.id(from), graph_.id(to), from_node->first, to_node->first});
+    }
+    catch (...)
+    {
+        topological_order_.removeDependency(from_node->first, to_node->first);
+        throw;
+    }
+    if (journal_)
+        journal_->recordAddEdge(graph_.id(from), graph_.id(to));
 
     from_node->second->onConnect();
+    return edge_id;
 }
 
 void GraphImpl::removeEdge(const EdgeId id)
 {
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
-    for (boost::tie(vi, vi_end) = boost::vertices(graph_); vi != vi_end; ++vi)
+    DTDF_PROFILE_SCOPE(profiler_, TimingScope::remove_edge);
+    auto edge_it = edge_index_.find(id);
+    if (edge_it == edge_index_.end())
+        return;
+    const auto edge_desc = edge_it->second.edge;
+    if (journal_)
     {
-        if (graph_[*vi].type == VertexType::output)
-        {
-            auto edges = boost::out_edges(*vi, graph_);
-            for (auto eeit = edges.first; eeit != edges.second; ++eeit)
-            {
-                const auto &edge_prop = boost::get(EdgeInfo_t(), graph_, *eeit);
-                if (edge_prop.id == id)
-                {
-                    const auto edge_source = boost::source(*eeit, graph_);
-                    auto node_source = findNodeById(graph_[edge_source].parent_id);
-                    node_source->beforeDisconnect();
-                    edge_prop.connection->connection.disconnect();
-                    boost::remove_edge(*eeit, graph_);
-                    break;
-                }
-            }
-        }
+        const auto &link = links_[edge_it->second.link_pos];
+        journal_->recordRemoveEdge(link.from, link.to);
     }
+    eraseLink(id);
+
+    if (auto node_source = findNodeById(graph_.parentId(graph_.source(edge_desc))); node_source)
+        node_source->beforeDisconnect();
+    graph_.edge(edge_desc).connection.connection.disconnect();
+    graph_.removeEdge(edge_desc);
 }
 
-VertexDesc GraphImpl::findVertexById(const NodeId id) const
+std::size_t GraphImpl::applyPendingCommands()
 {
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
-    for (boost::tie(vi, vi_end) = boost::vertices(graph_); vi != vi_end; ++vi)
+    // commands which are queued while applying are left for the next frame, so that a busy producer can't stall it
+    const auto pending = commands_.size();
+    std::size_t applied = 0;
+    GraphCommand command;
+    while (applied < pending && commands_.tryPop(command))
     {
-        if (graph_[*vi].id == id)
-            return *vi;
+        command(*this);
+        applied++;
     }
-    throw std::out_of_range("vertex with id not found");
+    return applied;
+}
+
+std::size_t GraphImpl::execute(const NodeTask &task)
+{
+    return schedule_.run(workerPool(), task, [this](const NodeId id) {
+        const auto node_it = nodes_.find(id);
+        return node_it != nodes_.end() ? node_it->second.get() : nullptr;
+    });
+}
+
+AllocatorStats GraphImpl::allocatorStats() const
+{
+    return memory_.stats();
+}
+
+std::vector<NodeId> GraphImpl::topologicalOrder() const
+{
+    return topological_order_.order();
+}
+
+void GraphImpl::recordTiming(const TimingScope scope, const float micros)
+{
+#ifdef DTDFEDITOR_PROFILING
+    profiler_.record(scope, micros);
+#else
+    (void)scope;
+    (void)micros;
+#endif
+}
+
+TimingStats GraphImpl::timingStats(const TimingScope scope) const
+{
+#ifdef DTDFEDITOR_PROFILING
+    return profiler_.stats(scope);
+#else
+    return TimingStats{};
+#endif
 }
 
-void GraphImpl::removeNodeSlots(const SlotMap &slots)
+TimingStats GraphImpl::nodeTimingStats(const NodeId id) const
 {
-    for (const auto &slot : slots)
+#ifdef DTDFEDITOR_PROFILING
+    return profiler_.nodeStats(id);
+#else
+    return TimingStats{};
+#endif
+}
+
+void GraphImpl::renderTimingOverlay(bool *open) const
+{
+    if (headless_)
+        return;
+    if (!ImGui::Begin("Graph timings", open))
     {
-        removeSlot(slot.second->id());
+        ImGui::End();
+        return;
     }
+#ifdef DTDFEDITOR_PROFILING
+    constexpr ImGuiTableFlags kTableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+    const auto statsColumns = [](const TimingStats &stats) {
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", stats.min_us);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", stats.avg_us);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", stats.p99_us);
+    };
+    if (ImGui::BeginTable("scopes", 4, kTableFlags))
+    {
+        ImGui::TableSetupColumn("scope");
+        ImGui::TableSetupColumn("min us");
+        ImGui::TableSetupColumn("avg us");
+        ImGui::TableSetupColumn("p99 us");
+        ImGui::TableHeadersRow();
+        for (std::size_t i = 0; i < static_cast<std::size_t>(TimingScope::count); i++)
+        {
+            const auto scope = static_cast<TimingScope>(i);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(timingScopeName(scope).data());
+            statsColumns(profiler_.stats(scope));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextUnformatted("slowest nodes");
+    if (ImGui::BeginTable("nodes", 5, kTableFlags))
+    {
+        ImGui::TableSetupColumn("id");
+        ImGui::TableSetupColumn("node");
+        ImGui::TableSetupColumn("min us");
+        ImGui::TableSetupColumn("avg us");
+        ImGui::TableSetupColumn("p99 us");
+        ImGui::TableHeadersRow();
+        for (const auto &[id, stats] : profiler_.slowestNodes(kOverlayNodes))
+        {
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", id);
+            ImGui::TableNextColumn();
+            if (auto node_it = nodes_.find(id); node_it != nodes_.end())
+                ImGui::TextUnformatted(node_it->second->key().c_str());
+            statsColumns(stats);
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextUnformatted("built without DTDFEDITOR_ENABLE_PROFILING");
+#endif
+    ImGui::End();
+}
+
+VertexDesc GraphImpl::findVertexById(const NodeId id) const
+{
+    auto vertex_it = vertex_index_.find(id);
+    if (vertex_it == vertex_index_.end())
+        throw std::out_of_range("vertex with id not found");
+    return vertex_it->second;
 }
 
 SlotPtr GraphImpl::findSlotById(const SlotId id) const
@@ -313,13 +827,14 @@ SlotPtr GraphImpl::findSlotById(const SlotId id) const
     try
     {
         const auto slot_desc = findVertexById(id);
-        assert(("id is not an slot id", graph_[slot_desc].type != VertexType::node));
-        assert(("parent isn't set", graph_[slot_desc].parent_id >= 0));
-        if (auto nit = nodes_.find(graph_[slot_desc].parent_id); nit != nodes_.end())
+        const auto slot_type = graph_.type(slot_desc);
+        assert(("id is not an slot id", slot_type != VertexType::node));
+        assert(("parent isn't set", graph_.parentId(slot_desc) >= 0));
+        if (auto nit = nodes_.find(graph_.parentId(slot_desc)); nit != nodes_.end())
         {
-            if (graph_[slot_desc].type == VertexType::input)
+            if (slot_type == VertexType::input)
                 return nit->second->inputs(id);
-            else if (graph_[slot_desc].type == VertexType::output)
+            else if (slot_type == VertexType::output)
                 return nit->second->outputs(id);
         }
     }
@@ -338,125 +853,635 @@ NodePtr GraphImpl::findNodeById(const NodeId node_id) const
 
 void GraphImpl::renderNodes()
 {
-    for (auto &node : nodes_)
+    if (headless_)
+        return;
+    DTDF_PROFILE_SCOPE(profiler_, TimingScope::render_nodes);
+    frame_++;
+    // grid space = screen space - canvas origin - panning
+    const auto panning = imnodes::EditorContextGetPanning();
+    const auto canvas_size = ImGui::GetWindowSize();
+    const NodeRect visible_area{-panning.x - kCullingMargin,
+                                -panning.y - kCullingMargin,
+                                canvas_size.x + 2.f * kCullingMargin,
+                                canvas_size.y + 2.f * kCullingMargin};
+    visible_nodes_.clear();
+    spatial_grid_.query(visible_area, visible_nodes_);
+    visible_nodes_.insert(visible_nodes_.end(), unplaced_nodes_.begin(), unplaced_nodes_.end());
+    unplaced_nodes_.clear();
+
+    // too many nodes on the canvas to read anything. skip the widgets of the plugins.
+    if (max_detailed_nodes_ == 0)
+        detailed_ = true;
+    else if (detailed_)
+        detailed_ = visible_nodes_.size() <= max_detailed_nodes_;
+    else
+        detailed_ = visible_nodes_.size() * 100 <= max_detailed_nodes_ * kDetailHysteresisPercent;
+    const bool detailed = detailed_;
+    visible_nodes_.insert(visible_nodes_.end(), selected_nodes_.begin(), selected_nodes_.end());
+    for (const auto node_id : visible_nodes_)
+    {
+        if (!wasRendered(node_id))
+            renderNode(node_id, detailed);
+    }
+
+    // a drag moves the nodes every frame. only the position at its end is journaled.
+    if (!moved_nodes_.empty() && !ImGui::IsMouseDown(ImGuiMouseButton_Left))
+        journalMovedNodes();
+}
+
+void GraphImpl::journalMovedNodes()
+{
+    if (journal_)
     {
-        node.second->render();
+        for (const auto id : moved_nodes_)
+        {
+            if (const auto *rect = spatial_grid_.rect(id); rect)
+                journal_->recordMoveNode(id, rect->x, rect->y);
+        }
     }
+    moved_nodes_.clear();
 }
 
 void GraphImpl::renderLinks()
 {
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
-    for (boost::tie(vi, vi_end) = boost::vertices(graph_); vi != vi_end; ++vi)
+    if (headless_)
+        return;
+    DTDF_PROFILE_SCOPE(profiler_, TimingScope::render_links);
+    for (const auto &link : links_)
     {
-        if (graph_[*vi].type == VertexType::output)
+        const bool from_rendered = wasRendered(link.from_node);
+        const bool to_rendered = wasRendered(link.to_node);
+        // links between two culled nodes are skipped, even if they cross the canvas. finding those would need a
+        // lookup of both node rects for almost every link of a large graph each frame.
+        if (!from_rendered && !to_rendered)
+            continue;
+        // imnodes needs both pins of a link. Pull in the culled end of links leaving the canvas.
+        if (!from_rendered)
+            renderNode(link.from_node, false);
+        else if (!to_rendered)
+            renderNode(link.to_node, false);
+        imnodes::Link(link.id, link.from, link.to);
+    }
+}
+
+void GraphImpl::setLevelOfDetailThreshold(const std::size_t max_detailed_nodes)
+{
+    max_detailed_nodes_ = max_detailed_nodes;
+}
+
+void GraphImpl::renderNode(const NodeId id, const bool detailed)
+{
+    auto node_it = nodes_.find(id);
+    if (node_it == nodes_.end())
+        return;
+    if (static_cast<std::size_t>(id) >= render_stamps_.size())
+        render_stamps_.resize(static_cast<std::size_t>(id) + 1, 0);
+    // imnodes frees the state of nodes which weren't submitted in the last frame. restore the known position.
+    if (render_stamps_[id] == 0 || render_stamps_[id] + 1 != frame_)
+    {
+        if (const auto *rect = spatial_grid_.rect(id); rect)
+            imnodes::SetNodeGridSpacePos(id, ImVec2{rect->x, rect->y});
+    }
+    render_stamps_[id] = frame_;
+
+    {
+        DTDF_PROFILE_NODE(profiler_, id);
+        if (detailed)
         {
-            const auto output_it = boost::out_edges(*vi, graph_);
-            for (auto eeit = output_it.first; eeit != output_it.second; ++eeit)
+            // the plugins draw the pins of detailed nodes themselves. mark the whole node if one of them fits.
+            bool accepts_link = false;
+            if (dragged_slot_id_ >= 0)
             {
-                const auto &edge_prop = boost::get(EdgeInfo_t(), graph_, *eeit);
-                imnodes::Link(edge_prop.id, graph_[*vi].id, graph_[boost::target(*eeit, graph_)].id);
+                const auto &slots = dragged_slot_type_ == SlotType::output ? node_it->second->inputs()
+                                                                           : node_it->second->outputs();
+                const auto slot_type = dragged_slot_type_ == SlotType::output ? SlotType::input : SlotType::output;
+                for (const auto &slot : slots)
+                {
+                    accepts_link = acceptsDraggedLink(id, slot.first, slot_type);
+                    if (accepts_link)
+                        break;
+                }
             }
+            if (accepts_link)
+                imnodes::PushColorStyle(imnodes::ColorStyle_TitleBar, kCompatiblePinColor);
+            node_it->second->render();
+            if (accepts_link)
+                imnodes::PopColorStyle();
         }
+        else
+            renderNodeProxy(node_it->second);
     }
+
+    // nodes can only be moved while they are rendered, so refreshing the rendered ones keeps the grid up to date
+    const auto position = imnodes::GetNodeGridSpacePos(id);
+    const auto dimensions = imnodes::GetNodeDimensions(id);
+    // the initial placement is part of the project file or the add_node record. moves are journaled once they end.
+    if (journal_)
+    {
+        const auto *prev_rect = spatial_grid_.rect(id);
+        if (prev_rect && (prev_rect->x != position.x || prev_rect->y != position.y))
+            moved_nodes_.insert(id);
+    }
+    spatial_grid_.update(id, NodeRect{position.x, position.y, dimensions.x, dimensions.y});
 }
 
-void GraphImpl::save(const std::filesystem::path &file)
+void GraphImpl::renderNodeProxy(const NodePtr &node) const
 {
-#if 0
-    using json = nlohmann::json;
+    imnodes::BeginNode(node->id());
 
-    json all_json;
-    json nodes_json = json::array();
-    for (const auto &node : nodes_)
+    imnodes::BeginNodeTitleBar();
+    if (const auto key_id = node_key_ids_[node->id()]; key_id != kInvalidKeyId)
+        ImGui::TextUnformatted(node_titles_[key_id].c_str());
+    else
+        ImGui::TextUnformatted(node->key().c_str());
+    imnodes::EndNodeTitleBar();
+
+    // the pins are still needed for the links
+    for (const auto &slot : node->inputs())
     {
-        //nodes_json.push_back(*node.second);
+        const bool highlight = acceptsDraggedLink(node->id(), slot.first, SlotType::input);
+        if (highlight)
+            imnodes::PushColorStyle(imnodes::ColorStyle_Pin, kCompatiblePinColor);
+        imnodes::BeginInputAttribute(slot.first);
+        ImGui::Dummy(ImVec2{kProxyPinWidth, 0.f});
+        imnodes::EndInputAttribute();
+        if (highlight)
+            imnodes::PopColorStyle();
+    }
+    for (const auto &slot : node->outputs())
+    {
+        const bool highlight = acceptsDraggedLink(node->id(), slot.first, SlotType::output);
+        if (highlight)
+            imnodes::PushColorStyle(imnodes::ColorStyle_Pin, kCompatiblePinColor);
+        imnodes::BeginOutputAttribute(slot.first);
+        ImGui::Dummy(ImVec2{kProxyPinWidth, 0.f});
+        imnodes::EndOutputAttribute();
+        if (highlight)
+            imnodes::PopColorStyle();
     }
-    all_json["nodes"] = std::move(nodes_json);
 
-    json edges_json = json::array();
-    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
-    for (boost::tie(ei, ei_end) = boost::edges(graph_); ei != ei_end; ++ei)
+    imnodes::EndNode();
+}
+
+void GraphImpl::updateLinkDrag()
+{
+    if (headless_)
+        return;
+    int started_at_attribute_id;
+    if (imnodes::IsLinkStarted(&started_at_attribute_id))
     {
-        const auto &source_info = graph_[boost::source(*ei, graph_)];
-        const auto &target_info = graph_[boost::target(*ei, graph_)];
-        // only save outside linkage
-        if (source_info.type != VertexType::node && target_info.type != VertexType::node)
-            edges_json.emplace_back(json{graph_[boost::source(*ei, graph_)].id, graph_[boost::target(*ei, graph_)].id});
+        dragged_slot_id_ = -1;
+        const auto vertex_it = vertex_index_.find(started_at_attribute_id);
+        if (vertex_it == vertex_index_.end() || graph_.type(vertex_it->second) == VertexType::node)
+            return;
+        if (slot_keys_.size() != slot_compatibility_.keyCount())
+            buildSlotCompatibility();
+        dragged_slot_id_ = started_at_attribute_id;
+        dragged_slot_type_ =
+            graph_.type(vertex_it->second) == VertexType::output ? SlotType::output : SlotType::input;
+        dragged_slot_node_ = graph_.parentId(vertex_it->second);
     }
-    all_json["links"] = std::move(edges_json);
+    else if (dragged_slot_id_ >= 0 && !ImGui::IsMouseDown(ImGuiMouseButton_Left))
+        dragged_slot_id_ = -1;
+}
 
-    std::ofstream o(file);
-    o << all_json << std::endl;
-#endif
+void GraphImpl::trackSelection()
+{
+    if (headless_)
+        return;
+    selected_nodes_.resize(static_cast<std::size_t>(imnodes::NumSelectedNodes()));
+    if (!selected_nodes_.empty())
+        imnodes::GetSelectedNodes(selected_nodes_.data());
+}
+
+bool GraphImpl::acceptsDraggedLink(const NodeId node_id, const SlotId id, const SlotType type) const
+{
+    // a link back to the own node would close a cycle
+    if (dragged_slot_id_ < 0 || type == dragged_slot_type_ || node_id == dragged_slot_node_)
+        return false;
+    // same check as addEdge, so exactly the pins which would accept the link are highlighted
+    return dragged_slot_type_ == SlotType::output ? canConnectSlots(dragged_slot_id_, id)
+                                                  : canConnectSlots(id, dragged_slot_id_);
+}
+
+bool GraphImpl::wasRendered(const NodeId id) const
+{
+    return static_cast<std::size_t>(id) < render_stamps_.size() && render_stamps_[id] == frame_;
 }
 
-void GraphImpl::clearAndLoad(const std::filesystem::path &file)
+void GraphImpl::save(const std::filesystem::path &file)
+{
+    // a crash while writing must not destroy the project file, the journal is useless without it
+    const bool json_file = isJsonFile(file);
+    replaceFile(file, [this, json_file](const std::filesystem::path &tmp_file) {
+        if (json_file)
+            saveJson(tmp_file);
+        else
+            saveSnapshot(tmp_file);
+    });
+
+    // the project file contains everything now. start with an empty journal.
+    project_file_ = file;
+    journal_.reset();
+    if (journal_enabled_)
+        journal_ = std::make_unique<EditJournal>(journalFile(project_file_), true);
+}
+
+void GraphImpl::clearAndLoad(const std::filesystem::path &file, const LoadMode mode)
 {
-#if 0
-    using nlohmann::json;
     if (!std::filesystem::exists(file) || !std::filesystem::is_regular_file(file))
     {
         return;
     }
-    clear();
+    journal_.reset();
+    if (isJsonFile(file))
+        loadJson(file, mode);
+    else
+        loadSnapshot(file, mode);
 
-    json j;
+    project_file_ = file;
+    if (journal_enabled_)
     {
-        std::ifstream file_input{file};
-        file_input >> j;
+        // edits which weren't saved to the project file yet
+        replayJournal(journalFile(project_file_));
+        journal_ = std::make_unique<EditJournal>(journalFile(project_file_), false);
     }
+}
+
+void GraphImpl::setJournalEnabled(const bool enabled)
+{
+    journal_enabled_ = enabled;
+    if (!enabled)
+        journal_.reset();
+    else if (!journal_ && !project_file_.empty())
+        journal_ = std::make_unique<EditJournal>(journalFile(project_file_), false);
+}
+
+void GraphImpl::replayJournal(const std::filesystem::path &file)
+{
+    // replaying the same edit twice has no effect. this happens if the app crashed between saving and truncating.
+    EditJournal::replay(file, [this](const EditJournal::Record &record) {
+        switch (record.op)
+        {
+        case JournalOp::add_node: {
+            if (nodes_.contains(record.node))
+                break;
+            activateLazyPlugins(NodeKey{record.key});
+            try
+            {
+                if (auto node = deserializeNode(NodeKey{record.key},
+                                                nlohmann::json::from_msgpack(record.state.begin(), record.state.end()));
+                    node)
+                {
+                    addNode(node);
+                    placeNode(node, record.x, record.y);
+                }
+            }
+            catch (const nlohmann::json::exception &)
+            {
+                Utility::Error{} << "The journaled state of node" << record.node << "is corrupt.";
+            }
+            break;
+        }
+        case JournalOp::remove_node:
+            removeNode(record.node);
+            break;
+        case JournalOp::add_edge:
+            if (findLink(record.from, record.to))
+                break;
+            try
+            {
+                addEdge(findVertexById(record.from), findVertexById(record.to));
+            }
+            catch (const std::logic_error &)
+            {}
+            break;
+        case JournalOp::remove_edge:
+            if (const auto link_id = findLink(record.from, record.to); link_id)
+                removeEdge(*link_id);
+            break;
+        case JournalOp::move_node:
+            if (const auto node = findNodeById(record.node); node)
+                placeNode(node, record.x, record.y);
+            break;
+        case JournalOp::register_slot:
+            registerSlot(record.node, record.from, record.slot_type);
+            break;
+        case JournalOp::unregister_slot:
+            unregisterSlot(record.node, record.from);
+            break;
+        }
+    });
+
+    int highest_vertex_id = vertex_id_counter_ - 1;
+    for (const auto &vertex : vertex_index_)
+        highest_vertex_id = std::max(highest_vertex_id, vertex.first);
+    vertex_id_counter_ = highest_vertex_id + 1;
+}
+
+std::optional<EdgeId> GraphImpl::findLink(const SlotId from, const SlotId to) const
+{
+    auto vertex_it = vertex_index_.find(from);
+    if (vertex_it == vertex_index_.end())
+        return std::nullopt;
+    std::optional<EdgeId> link_id;
+    graph_.forEachOutEdge(vertex_it->second, [this, to, &link_id](const EdgeDesc edge) {
+        if (!link_id && graph_.id(graph_.target(edge)) == to)
+            link_id = graph_.edge(edge).id;
+    });
+    return link_id;
+}
+
+void GraphImpl::placeNode(const NodePtr &node, const float x, const float y)
+{
+    if (!headless_)
+        node->setPosition(static_cast<int>(x), static_cast<int>(y), false);
+    // known before the first render. keeps the position for saving and avoids journaling the initial placement
+    const auto *rect = spatial_grid_.rect(node->id());
+    spatial_grid_.update(node->id(), NodeRect{x, y, rect ? rect->width : 0.f, rect ? rect->height : 0.f});
+}
 
-    const json &node_arr = j["nodes"];
-    for (const auto &node_j : node_arr)
+void GraphImpl::saveSnapshot(const std::filesystem::path &file) const
+{
+    snapshot::SnapshotWriter writer;
+    std::vector<snapshot::SlotRecord> slots;
+    for (const auto &[node_id, node] : nodes_)
     {
-        auto node_factory = getNodeDeserializationFactory(node_j["key"]);
-        addNode(node_factory(*this, node_j));
+        slots.clear();
+        for (const auto &slot : node->inputs())
+            slots.emplace_back(snapshot::SlotRecord{slot.first, static_cast<std::uint32_t>(SlotType::input)});
+        for (const auto &slot : node->outputs())
+            slots.emplace_back(snapshot::SlotRecord{slot.first, static_cast<std::uint32_t>(SlotType::output)});
+
+        const auto position = nodePosition(node_id);
+        const auto state = nlohmann::json::to_msgpack(nlohmann::json(*node));
+        writer.addNode(node_id, node->key(), position.x, position.y, slots, state);
     }
-    const json &link_arr = j["links"];
-    for (const auto &link_j : link_arr)
+    for (const auto &link : links_)
     {
-        if (link_j.size() == 2)
+        writer.addLink(link.from, link.to);
+    }
+    writer.write(file, vertex_id_counter_);
+}
+
+void GraphImpl::loadSnapshot(const std::filesystem::path &file, const LoadMode mode)
+{
+    // validate the whole file before the current graph is thrown away
+    const snapshot::SnapshotReader reader{file};
+    clear();
+
+    // plugins are activated on this thread, before the factories might run on the worker pool
+    for (std::uint32_t key_index = 0; key_index < reader.numKeys(); key_index++)
+        activateLazyPlugins(NodeKey{reader.key(key_index)});
+
+    const auto records = reader.nodes();
+    const auto deserialize = [this, &reader](const snapshot::NodeRecord &record) -> NodePtr {
+        const NodeKey key{reader.key(record.key_index)};
+        const auto state = reader.blob(record);
+        try
         {
-            try
+            return deserializeNode(key, nlohmann::json::from_msgpack(state.begin(), state.end()));
+        }
+        catch (const nlohmann::json::exception &)
+        {
+            Utility::Error{} << "The state of node" << key.c_str() << "is corrupt.";
+        }
+        return nullptr;
+    };
+    std::vector<std::future<NodePtr>> deserialized_nodes;
+    if (mode == LoadMode::parallel)
+    {
+        deserialized_nodes.reserve(records.size());
+        for (const auto &record : records)
+        {
+            deserialized_nodes.emplace_back(
+                workerPool().submit([&deserialize, record] { return deserialize(record); }));
+        }
+    }
+
+    try
+    {
+        // nodes are added in file order regardless of the load mode
+        for (std::size_t i = 0; i < records.size(); i++)
+        {
+            const auto &record = records[i];
+            auto node = mode == LoadMode::parallel ? deserialized_nodes[i].get() : deserialize(record);
+            if (!node)
+                continue;
+            addNode(node);
+            placeNode(node, record.x, record.y);
+
+            const NodeKey key{reader.key(record.key_index)};
+            if (node->id() != record.id)
+                Utility::Warning{} << "The node" << key.c_str() << "was restored with a different id.";
+            for (const auto &slot : reader.slots(record))
             {
-                addEdge(findVertexById(link_j.at(0)), findVertexById(link_j.at(1)));
+                const auto slot_ptr = static_cast<SlotType>(slot.type) == SlotType::input ? node->inputs(slot.id)
+                                                                                          : node->outputs(slot.id);
+                if (!slot_ptr)
+                    Utility::Warning{} << "The node" << key.c_str() << "was restored without the slot" << slot.id;
             }
-            catch (...)
-            {}
         }
     }
-    for (const auto &link_j : link_arr)
+    catch (...)
+    {
+        // the pending tasks reference deserialize and the mapped file, both must outlive them
+        for (auto &deserialized_node : deserialized_nodes)
+        {
+            if (deserialized_node.valid())
+                deserialized_node.wait();
+        }
+        throw;
+    }
+    for (const auto &link : reader.links())
     {
-        if (link_j.size() == 2)
+        try
         {
-            auto source = findSlotById(link_j.at(0));
+            addEdge(findVertexById(link.from), findVertexById(link.to));
         }
+        catch (const std::logic_error &)
+        {}
     }
-    int highest_vertex_id = 0;
-    for (const auto &node : nodes_)
+    vertex_id_counter_ = reader.header().next_vertex_id;
+}
+
+void GraphImpl::saveJson(const std::filesystem::path &file) const
+{
+    using json = nlohmann::json;
+
+    json nodes_json = json::array();
+    for (const auto &[node_id, node] : nodes_)
+    {
+        json node_json = *node;
+        const auto position = nodePosition(node_id);
+        node_json[kJsonPositionKey] = json::array({position.x, position.y});
+        nodes_json.emplace_back(std::move(node_json));
+    }
+
+    json links_json = json::array();
+    for (const auto &link : links_)
+    {
+        links_json.emplace_back(json::array({link.from, link.to}));
+    }
+
+    json all_json;
+    all_json["nodes"] = std::move(nodes_json);
+    all_json["links"] = std::move(links_json);
+
+    std::ofstream o(file);
+    o << all_json << std::endl;
+    if (!o)
+        throw std::runtime_error("can't write json graph file");
+}
+
+void GraphImpl::loadJson(const std::filesystem::path &file, const LoadMode mode)
+{
+    using json = nlohmann::json;
+
+    std::ifstream file_input{file};
+    clear();
+
+    struct PendingNode
     {
-        if (node.second->id() > highest_vertex_id)
-            highest_vertex_id = node.second->id();
-        for (const auto &slot : node.second->inputs())
+        std::future<NodePtr> node;
+        std::optional<ImVec2> position;
+    };
+    // nodes which are deserialized on the worker pool. they are added in file order as soon as they are ready.
+    std::deque<PendingNode> pending_nodes;
+    // links may appear before their nodes. they are wired once both slots exist
+    std::vector<std::pair<SlotId, SlotId>> pending_links;
+
+    const auto add_node = [this](const NodePtr &node, const std::optional<ImVec2> &position) {
+        if (!node)
+            return;
+        addNode(node);
+        if (position)
+            placeNode(node, position->x, position->y);
+    };
+    const auto add_pending_nodes = [&pending_nodes, &add_node](const bool wait) {
+        while (!pending_nodes.empty() &&
+               (wait || pending_nodes.front().node.wait_for(std::chrono::seconds{0}) == std::future_status::ready))
         {
-            if (slot.second->id() > highest_vertex_id)
-                highest_vertex_id = slot.second->id();
+            add_node(pending_nodes.front().node.get(), pending_nodes.front().position);
+            pending_nodes.pop_front();
         }
-        for (const auto &slot : node.second->outputs())
+    };
+
+    GraphJsonReader reader{
+        [this, mode, &pending_nodes, &add_node, &add_pending_nodes](json &&node_json) {
+            const auto key_it = node_json.find("key");
+            if (key_it == node_json.end() || !key_it->is_string())
+            {
+                Utility::Error{} << "Skipping a node without a key.";
+                return;
+            }
+            auto key = key_it->get<NodeKey>();
+            std::optional<ImVec2> position;
+            const auto position_it = node_json.find(kJsonPositionKey);
+            if (position_it != node_json.end() && position_it->is_array() && position_it->size() == 2)
+                position = ImVec2{(*position_it)[0].get<float>(), (*position_it)[1].get<float>()};
+            // activation registers factories, which the workers must not see halfway. let them finish first.
+            if (mode == LoadMode::parallel && needsLazyActivation(key))
+                add_pending_nodes(true);
+            activateLazyPlugins(key);
+
+            if (mode == LoadMode::parallel)
+            {
+                pending_nodes.emplace_back(PendingNode{
+                    workerPool().submit([this, key = std::move(key), node_json = std::move(node_json)] {
+                        return deserializeNode(key, node_json);
+                    }),
+                    position});
+                add_pending_nodes(false);
+            }
+            else
+                add_node(deserializeNode(key, node_json), position);
+        },
+        [this, &pending_links](const SlotId from, const SlotId to) {
+            if (!vertex_index_.contains(from) || !vertex_index_.contains(to))
+            {
+                pending_links.emplace_back(from, to);
+                return;
+            }
+            try
+            {
+                addEdge(vertex_index_.at(from), vertex_index_.at(to));
+            }
+            catch (const std::invalid_argument &)
+            {}
+        }};
+    const bool parsed = json::sax_parse(file_input, &reader);
+    add_pending_nodes(true);
+
+    for (const auto &[from, to] : pending_links)
+    {
+        try
         {
-            if (slot.second->id() > highest_vertex_id)
-                highest_vertex_id = slot.second->id();
+            addEdge(findVertexById(from), findVertexById(to));
         }
+        catch (const std::logic_error &)
+        {}
     }
+
+    int highest_vertex_id = -1;
+    for (const auto &vertex : vertex_index_)
+        highest_vertex_id = std::max(highest_vertex_id, vertex.first);
     vertex_id_counter_ = highest_vertex_id + 1;
-#endif
+
+    if (!parsed)
+        throw std::runtime_error(reader.error());
+}
+
+NodePtr GraphImpl::deserializeNode(const NodeKey &key, const nlohmann::json &state)
+{
+    try
+    {
+        return getNodeDeserializationFactory(key)(*this, state);
+    }
+    catch (const std::out_of_range &)
+    {
+        Utility::Error{} << "The node" << key.c_str() << "cannot be restored.";
+    }
+    catch (const nlohmann::json::exception &)
+    {
+        Utility::Error{} << "The node" << key.c_str() << "cannot be restored from its state.";
+    }
+    return nullptr;
+}
+
+ThreadPool &GraphImpl::workerPool()
+{
+    if (!worker_pool_)
+        worker_pool_ = std::make_unique<ThreadPool>();
+    return *worker_pool_;
+}
+
+ImVec2 GraphImpl::nodePosition(const NodeId id) const
+{
+    if (const auto *rect = spatial_grid_.rect(id); rect)
+        return ImVec2{rect->x, rect->y};
+    return headless_ ? ImVec2{0.f, 0.f} : imnodes::GetNodeGridSpacePos(id);
 }
 
 void GraphImpl::clear()
 {
-    graph_.clear();
-    nodes_.clear();
+    // drop everything which lives in the arena, then hand all of its chunks back at once
+    memory_.reset(graph_, nodes_, vertex_index_, edge_index_, links_, free_vertices_);
+    spatial_grid_.clear();
+    unplaced_nodes_.clear();
+    topological_order_.clear();
+    render_stamps_.clear();
+    selected_nodes_.clear();
+    moved_nodes_.clear();
+    node_key_ids_.clear();
+    slot_key_ids_.clear();
+    dragged_slot_id_ = -1;
+#ifdef DTDFEDITOR_PROFILING
+    profiler_.clear();
+#endif
+    // the graph doesn't belong to the project file anymore
+    journal_.reset();
+    project_file_.clear();
     link_id_counter_ = 0;
     vertex_id_counter_ = 0;
 }
@@ -466,6 +1491,11 @@ const NodeDisplayGraph &GraphImpl::nodeDisplayNames() const
     return node_display_names_;
 }
 
+const NodeSearchIndex &GraphImpl::nodeSearchIndex() const
+{
+    return node_search_index_;
+}
+
 GraphImpl::~GraphImpl()
 {}
 } // namespace dt::df::editor
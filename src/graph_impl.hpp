@@ -1,25 +1,48 @@
 #pragma once
 #include <atomic>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <optional>
+#include <span>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <Corrade/PluginManager/Manager.h>
+#include <imgui.h>
+#include <nlohmann/json_fwd.hpp>
 
 #include <dt/df/core/graph_manager.hpp>
 
 #include <dt/df/plugin/plugin.hpp>
-#include "bounded_buffer.hpp"
+#include "edit_journal.hpp"
+#include "execution_schedule.hpp"
+#include "graph_memory.hpp"
+#include "graph_store.hpp"
+#include "key_table.hpp"
 #include "node_display_tree.hpp"
+#include "node_search_index.hpp"
+#include "plugin_catalog.hpp"
 #include "priv_types.hpp"
+#include "profiler.hpp"
+#include "ring_buffer.hpp"
+#include "slot_compatibility.hpp"
+#include "spatial_grid.hpp"
+#include "thread_pool.hpp"
+#include "topological_order.hpp"
 namespace dt::df::editor
 {
 class GraphImpl final : public core::IGraphManager
 {
   public:
-    GraphImpl();
+    explicit GraphImpl(const RuntimeMode mode = RuntimeMode::gui);
     void init();
+    //! only loads the plugins which aren't in the catalog. all others are activated once one of their nodes is needed.
+    void init(const std::filesystem::path &catalog_file);
     void registerNodeFactory(const NodeKey &key,
                              const std::string &node_display_name,
                              NodeFactory &&factory,
@@ -35,43 +58,201 @@ class GraphImpl final : public core::IGraphManager
     bool registerSlot(const NodeId node_id, const SlotId slot_id, const SlotType type) override;
     bool unregisterSlot(const NodeId node_id, const SlotId slot_id) override;
 
-    void createNode(const NodeKey &key, int preferred_x, int preferred_y, bool screen_space);
+    NodeId createNode(const NodeKey &key, int preferred_x, int preferred_y, bool screen_space);
     void removeNode(const NodeId id);
-    void addEdge(const VertexDesc from, const VertexDesc to);
+    //! unknown and repeated ids are skipped
+    void removeNodes(std::span<const NodeId> ids);
+    //! returns -1 if the slots can't be connected or the link would close a cycle.
+    //! throws std::invalid_argument if from isn't an output slot or to isn't an input slot of an existing node.
+    EdgeId addEdge(const VertexDesc from, const VertexDesc to);
     void removeEdge(const EdgeId id);
     VertexDesc findVertexById(const NodeId id) const;
+    NodePtr findNodeById(const NodeId) const;
 
     void renderNodes();
     void renderLinks();
+    //! call after imnodes::EndNodeEditor. the pins which accept the dragged link are highlighted in the next frame.
+    void updateLinkDrag();
+    //! call after imnodes::EndNodeEditor. the selected nodes are submitted in the next frame even if they are culled.
+    void trackSelection();
+    void setLevelOfDetailThreshold(const std::size_t max_detailed_nodes);
 
     void save(const std::filesystem::path &file);
-    void clearAndLoad(const std::filesystem::path &file);
+    void clearAndLoad(const std::filesystem::path &file, const LoadMode mode);
     void clear();
+    void setJournalEnabled(const bool enabled);
+
+    //! thread safe. the command runs on the render thread with the next applyPendingCommands.
+    //! if the queue is full, the future holds a std::runtime_error instead of blocking the caller.
+    template <typename Fnc>
+    std::future<std::invoke_result_t<Fnc, GraphImpl &>> enqueueCommand(Fnc &&fnc)
+    {
+        using Result = std::invoke_result_t<Fnc, GraphImpl &>;
+        // std::function needs a copyable target, packaged_task isn't
+        auto task = std::make_shared<std::packaged_task<Result(GraphImpl &)>>(std::forward<Fnc>(fnc));
+        auto result = task->get_future();
+        if (commands_.tryPush([task](GraphImpl &graph) { (*task)(graph); }))
+            return result;
+
+        std::promise<Result> rejected;
+        rejected.set_exception(std::make_exception_ptr(std::runtime_error{"the graph command queue is full"}));
+        return rejected.get_future();
+    }
+    //! applies the commands which were queued up to now. returns the number of applied commands.
+    std::size_t applyPendingCommands();
+    std::size_t execute(const NodeTask &task);
+    std::vector<NodeId> topologicalOrder() const;
+
+    //! does nothing if profiling is disabled
+    void recordTiming(const TimingScope scope, const float micros);
+    TimingStats timingStats(const TimingScope scope) const;
+    TimingStats nodeTimingStats(const NodeId id) const;
+    AllocatorStats allocatorStats() const;
+    void renderTimingOverlay(bool *open) const;
     const NodeDisplayGraph &nodeDisplayNames() const;
+    const NodeSearchIndex &nodeSearchIndex() const;
     ~GraphImpl();
 
   private:
+    struct LoadedPlugin
+    {
+        std::string name;
+        //! created by manager_, which is declared before loaded_plugins_ and therefore outlives the instance
+        std::unique_ptr<plugin::Plugin> instance;
+    };
+    struct LazyPlugin
+    {
+        std::string name;
+        bool provides_slots;
+        bool active;
+    };
+    //! loads, sets up and registers the plugins. adds their factories to the catalog if there is one.
+    void activatePlugins(const std::vector<std::string> &plugin_names, PluginCatalog *catalog);
+    //! not thread safe, like the manager
+    LoadedPlugin loadPlugin(const std::string &plugin_name);
+    void forEachParallel(const std::size_t count, const std::function<void(const std::size_t index)> &fnc);
+    void addLazyPlugin(const CatalogPlugin &plugin);
+    //! makes sure that the factories for the node key are registered
+    void activateLazyPlugins(const NodeKey &key);
+    //! whether activateLazyPlugins would load a plugin and register factories for the key
+    bool needsLazyActivation(const NodeKey &key) const;
+    void addNodeDisplayName(const KeyId key_id, const std::string &node_display_name);
+    //! interns the key and grows the vectors indexed by the key id
+    KeyId internNodeKey(const NodeKey &key);
+    KeyId internSlotKey(const SlotKey &key);
+    //! asks a prototype slot of every registered key. called after init and whenever new slot keys were registered.
+    void buildSlotCompatibility();
+    KeyId slotKeyId(const SlotId id) const;
+    //! uses the compatibility matrix and asks the output slot directly for keys interned after the last build
+    bool canConnectSlots(const SlotId from, const SlotId to) const;
+    //! whether the pin accepts the link which is currently dragged
+    bool acceptsDraggedLink(const NodeId node_id, const SlotId id, const SlotType type) const;
     void addNode(const NodePtr &node);
+    //! thread safe as long as no factories are registered at the same time. returns nullptr on failure.
+    //! ids which the factory generates instead of restoring them depend on the order of the calls.
+    NodePtr deserializeNode(const NodeKey &key, const nlohmann::json &state);
+    void saveSnapshot(const std::filesystem::path &file) const;
+    void loadSnapshot(const std::filesystem::path &file, const LoadMode mode);
+    void saveJson(const std::filesystem::path &file) const;
+    void loadJson(const std::filesystem::path &file, const LoadMode mode);
+    ThreadPool &workerPool();
+    void replayJournal(const std::filesystem::path &file);
+    std::optional<EdgeId> findLink(const SlotId from, const SlotId to) const;
+    //! sets the position in grid space
+    void placeNode(const NodePtr &node, const float x, const float y);
     VertexDesc addSlot(const NodePtr &node, const VertexDesc node_vert, const SlotPtr &slot, const SlotType type);
     void removeSlot(const SlotId slot_id);
     const NodeFactory &getNodeFactory(const NodeKey &key) const;
     const NodeDeserializationFactory &getNodeDeserializationFactory(const NodeKey &key) const;
     VertexDesc addVertex(const VertexDesc node_desc, const int id, const int parent_id, VertexType type);
-    void removeNodeSlots(const SlotMap &slots);
+    void unindexEdges(const VertexDesc vertex);
+    void eraseLink(const EdgeId id);
+    void releaseVertex(const VertexDesc vertex);
+    void compactIfNeeded();
+    void compact();
+    void renderNode(const NodeId id, const bool detailed);
+    void renderNodeProxy(const NodePtr &node) const;
+    bool wasRendered(const NodeId id) const;
+    void journalMovedNodes();
+    ImVec2 nodePosition(const NodeId id) const;
     SlotPtr findSlotById(const SlotId) const;
-    NodePtr findNodeById(const NodeId) const;
 
   private:
+    const bool headless_;
     Corrade::PluginManager::Manager<plugin::Plugin> manager_;
-    std::vector<std::unique_ptr<plugin::Plugin>> loaded_plugins_;
-    Graph graph_;
+    std::vector<LoadedPlugin> loaded_plugins_;
+    //! plugins from the catalog. they are loaded when one of their nodes is created or deserialized.
+    std::vector<LazyPlugin> lazy_plugins_;
+    KeyTable node_keys_;
+    KeyTable slot_keys_;
+    //! index of the lazy plugin providing the node type, indexed by the node key id. kNoLazyPlugin if there is none.
+    std::vector<std::size_t> lazy_node_plugins_;
+    bool lazy_slot_providers_active_ = false;
+    //! backs the graph store, nodes_, the vertex and edge indexes and the link list. declared first to outlive them.
+    GraphMemory memory_;
+    GraphStore graph_{memory_.resource()};
     std::atomic_int link_id_counter_;
     std::atomic_int vertex_id_counter_;
-    std::unordered_map<NodeKey, NodeFactory> node_factories_;
-    std::unordered_map<NodeKey, NodeDeserializationFactory> node_deser_factories_;
-    std::unordered_map<SlotKey, SlotFactory> slot_factories_;
-    std::unordered_map<SlotKey, SlotDeserializationFactory> slot_deser_factories_;
-    NodeDisplayGraph node_display_names_;
-    std::unordered_map<NodeId, NodePtr> nodes_;
+    //! indexed by the key id. empty while a node type is only known from the plugin catalog.
+    std::vector<NodeFactory> node_factories_;
+    std::vector<NodeDeserializationFactory> node_deser_factories_;
+    std::vector<SlotFactory> slot_factories_;
+    std::vector<SlotDeserializationFactory> slot_deser_factories_;
+    NodeDisplayGraph node_display_names_{node_keys_};
+    NodeSearchIndex node_search_index_;
+    std::pmr::unordered_map<NodeId, NodePtr> nodes_{memory_.resource()};
+    //! last part of the display name, indexed by the key id. used as title when a node is drawn as a proxy
+    std::vector<std::string> node_titles_;
+    //! key id of every node, indexed by the node id. kInvalidKeyId for unregistered keys.
+    std::vector<KeyId> node_key_ids_;
+    //! key id of every slot, indexed by the slot id. kInvalidKeyId for unregistered keys.
+    std::vector<KeyId> slot_key_ids_;
+    SlotCompatibility slot_compatibility_;
+    //! set while buildSlotCompatibility creates its prototypes, which must not use up vertex ids
+    bool creating_slot_prototypes_ = false;
+    //! node and slot ids share one id space (vertex_id_counter_)
+    std::pmr::unordered_map<int, VertexDesc> vertex_index_{memory_.resource()};
+    //! only links between an output and an input slot are indexed
+    std::pmr::unordered_map<EdgeId, LinkRef> edge_index_{memory_.resource()};
+    std::pmr::vector<LinkInfo> links_{memory_.resource()};
+    //! cleared vertices which are reused by addVertex before the graph grows
+    std::pmr::vector<VertexDesc> free_vertices_{memory_.resource()};
+
+    NodeSpatialGrid spatial_grid_;
+    //! nodes which haven't been rendered yet and have therefore no known size
+    std::vector<NodeId> unplaced_nodes_;
+    std::vector<NodeId> visible_nodes_;
+    //! imnodes drops the selection of nodes which aren't submitted in a frame, so these are never culled
+    std::vector<NodeId> selected_nodes_;
+    //! nodes which moved since the last mouse release. their final position is journaled.
+    std::unordered_set<NodeId> moved_nodes_;
+    //! frame in which a node was rendered last. indexed by the node id
+    std::vector<std::uint32_t> render_stamps_;
+    std::uint32_t frame_ = 0;
+    std::size_t max_detailed_nodes_;
+    //! level of detail of the last frame
+    bool detailed_ = true;
+    //! the pin a link is dragged from. -1 while no link is dragged.
+    SlotId dragged_slot_id_ = -1;
+    SlotType dragged_slot_type_ = SlotType::output;
+    NodeId dragged_slot_node_ = -1;
+    //! created on first use
+    std::unique_ptr<ThreadPool> worker_pool_;
+
+    //! file of the last save or load. the journal is kept next to it.
+    std::filesystem::path project_file_;
+    bool journal_enabled_ = false;
+    //! only open while journaling is enabled and the graph belongs to a project file
+    std::unique_ptr<EditJournal> journal_;
+    //! node level order of the links. keeps the graph acyclic.
+    TopologicalOrder topological_order_;
+    //! runs along topological_order_
+    ExecutionSchedule schedule_{topological_order_};
+
+    using GraphCommand = std::function<void(GraphImpl &)>;
+    MpmcRing<GraphCommand> commands_;
+#ifdef DTDFEDITOR_PROFILING
+    Profiler profiler_;
+#endif
 };
 } // namespace dt::df::editor
@@ -0,0 +1,161 @@
+#include "graph_json_reader.hpp"
+
+namespace dt::df::editor
+{
+namespace
+{
+// depth of the root object, the nodes/links arrays and their elements
+constexpr std::size_t kRootDepth = 1;
+constexpr std::size_t kSectionDepth = 2;
+constexpr std::size_t kElementDepth = 3;
+} // namespace
+
+GraphJsonReader::GraphJsonReader(NodeCallback &&node_callback, LinkCallback &&link_callback)
+    : node_callback_{std::move(node_callback)}
+    , link_callback_{std::move(link_callback)}
+    , depth_{0}
+    , section_{Section::none}
+{}
+
+const std::string &GraphJsonReader::error() const
+{
+    return error_;
+}
+
+bool GraphJsonReader::null()
+{
+    return value(nullptr);
+}
+
+bool GraphJsonReader::boolean(bool val)
+{
+    return value(val);
+}
+
+bool GraphJsonReader::number_integer(number_integer_t val)
+{
+    return value(val);
+}
+
+bool GraphJsonReader::number_unsigned(number_unsigned_t val)
+{
+    return value(val);
+}
+
+bool GraphJsonReader::number_float(number_float_t val, const string_t &)
+{
+    return value(val);
+}
+
+bool GraphJsonReader::string(string_t &val)
+{
+    return value(std::move(val));
+}
+
+bool GraphJsonReader::binary(binary_t &val)
+{
+    return value(nlohmann::json::binary(std::move(val)));
+}
+
+bool GraphJsonReader::start_object(std::size_t)
+{
+    return startContainer(nlohmann::json::object());
+}
+
+bool GraphJsonReader::key(string_t &val)
+{
+    if (depth_ == kRootDepth)
+    {
+        if (val == "nodes")
+            section_ = Section::nodes;
+        else if (val == "links")
+            section_ = Section::links;
+        else
+            section_ = Section::skip;
+    }
+    else
+        key_ = std::move(val);
+    return true;
+}
+
+bool GraphJsonReader::end_object()
+{
+    return endContainer();
+}
+
+bool GraphJsonReader::start_array(std::size_t)
+{
+    return startContainer(nlohmann::json::array());
+}
+
+bool GraphJsonReader::end_array()
+{
+    return endContainer();
+}
+
+bool GraphJsonReader::parse_error(std::size_t, const std::string &, const nlohmann::json::exception &ex)
+{
+    error_ = ex.what();
+    return false;
+}
+
+bool GraphJsonReader::value(nlohmann::json &&val)
+{
+    if (!containers_.empty())
+        insert(std::move(val));
+    return true;
+}
+
+bool GraphJsonReader::startContainer(nlohmann::json &&container)
+{
+    depth_++;
+    if (!containers_.empty())
+        containers_.emplace_back(insert(std::move(container)));
+    else if (depth_ == kSectionDepth && !container.is_array())
+        section_ = Section::skip;
+    else if (depth_ == kElementDepth && (section_ == Section::nodes || section_ == Section::links))
+    {
+        element_ = std::move(container);
+        containers_.emplace_back(&element_);
+    }
+    return true;
+}
+
+bool GraphJsonReader::endContainer()
+{
+    if (!containers_.empty())
+    {
+        containers_.pop_back();
+        if (containers_.empty())
+            finishElement();
+    }
+    depth_--;
+    if (depth_ == kRootDepth)
+        section_ = Section::none;
+    return true;
+}
+
+nlohmann::json *GraphJsonReader::insert(nlohmann::json &&val)
+{
+    // only the innermost container is modified, so the pointers to its parents stay valid
+    auto &container = *containers_.back();
+    if (container.is_array())
+    {
+        container.push_back(std::move(val));
+        return &container.back();
+    }
+    auto &inserted = container[key_];
+    inserted = std::move(val);
+    return &inserted;
+}
+
+void GraphJsonReader::finishElement()
+{
+    if (section_ == Section::nodes && element_.is_object())
+        node_callback_(std::move(element_));
+    else if (section_ == Section::links && element_.is_array() && element_.size() == 2 &&
+             element_[0].is_number_integer() && element_[1].is_number_integer())
+        link_callback_(element_[0].get<SlotId>(), element_[1].get<SlotId>());
+    element_ = nullptr;
+}
+} // namespace dt::df::editor
@@ -0,0 +1,62 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <dt/df/core/types.hpp>
+#include <nlohmann/json.hpp>
+
+namespace dt::df::editor
+{
+//! SAX handler for json graph files of the form {"nodes": [{...}, ...], "links": [[from, to], ...]}.
+//! Only the node which is currently parsed is kept as json. Nodes and links are handed out as soon as they are complete.
+class GraphJsonReader final : public nlohmann::json_sax<nlohmann::json>
+{
+  public:
+    using NodeCallback = std::function<void(nlohmann::json &&node_json)>;
+    using LinkCallback = std::function<void(const SlotId from, const SlotId to)>;
+
+  public:
+    GraphJsonReader(NodeCallback &&node_callback, LinkCallback &&link_callback);
+    const std::string &error() const;
+
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, const string_t &s) override;
+    bool string(string_t &val) override;
+    bool binary(binary_t &val) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t &val) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string &last_token, const nlohmann::json::exception &ex) override;
+
+  private:
+    enum class Section
+    {
+        none,
+        nodes,
+        links,
+        skip
+    };
+    bool value(nlohmann::json &&val);
+    bool startContainer(nlohmann::json &&container);
+    bool endContainer();
+    nlohmann::json *insert(nlohmann::json &&val);
+    void finishElement();
+
+  private:
+    NodeCallback node_callback_;
+    LinkCallback link_callback_;
+    std::size_t depth_;
+    Section section_;
+    //! element of the nodes or links array which is currently built
+    nlohmann::json element_;
+    //! open containers inside element_. empty while no element is built
+    std::vector<nlohmann::json *> containers_;
+    std::string key_;
+    std::string error_;
+};
+} // namespace dt::df::editor
@@ -0,0 +1,72 @@
+#include "graph_memory.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace dt::df::editor
+{
+CountingResource::CountingResource(std::pmr::memory_resource *upstream)
+    : upstream_{upstream}
+{}
+
+std::size_t CountingResource::bytesInUse() const
+{
+    return bytes_in_use_;
+}
+
+std::size_t CountingResource::peakBytesInUse() const
+{
+    return peak_bytes_in_use_;
+}
+
+std::size_t CountingResource::allocations() const
+{
+    return allocations_;
+}
+
+void *CountingResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    auto *p = upstream_->allocate(bytes, alignment);
+    bytes_in_use_ += bytes;
+    peak_bytes_in_use_ = std::max(peak_bytes_in_use_, bytes_in_use_);
+    allocations_++;
+    return p;
+}
+
+void CountingResource::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+{
+    upstream_->deallocate(p, bytes, alignment);
+    assert(("deallocated more than allocated", bytes_in_use_ >= bytes));
+    bytes_in_use_ -= bytes;
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+GraphMemory::GraphMemory()
+    : system_{std::pmr::new_delete_resource()}
+    , pools_{&system_}
+    , requests_{&pools_}
+{}
+
+std::pmr::memory_resource *GraphMemory::resource()
+{
+    return &requests_;
+}
+
+void GraphMemory::release()
+{
+    assert(("graph records are still alive", requests_.bytesInUse() == 0));
+    pools_.release();
+}
+
+AllocatorStats GraphMemory::stats() const
+{
+    return AllocatorStats{requests_.bytesInUse(),
+                          requests_.peakBytesInUse(),
+                          requests_.allocations(),
+                          system_.bytesInUse(),
+                          system_.allocations()};
+}
+} // namespace dt::df::editor
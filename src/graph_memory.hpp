@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include "dt/df/editor/types.hpp"
+
+namespace dt::df::editor
+{
+//! forwards to the upstream resource and counts what passes through. Not thread safe.
+class CountingResource final : public std::pmr::memory_resource
+{
+  public:
+    explicit CountingResource(std::pmr::memory_resource *upstream);
+    std::size_t bytesInUse() const;
+    std::size_t peakBytesInUse() const;
+    std::size_t allocations() const;
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+  private:
+    std::pmr::memory_resource *upstream_;
+    std::size_t bytes_in_use_ = 0;
+    std::size_t peak_bytes_in_use_ = 0;
+    std::size_t allocations_ = 0;
+};
+
+//! per graph arena for the vertex, edge, link and node records.
+//! Small allocations are served from size-class pools which take their chunks from the system, so bulk creation and
+//! teardown rarely reach malloc. Not thread safe, like the graph containers which use it.
+class GraphMemory
+{
+  public:
+    GraphMemory();
+    GraphMemory(const GraphMemory &) = delete;
+    GraphMemory &operator=(const GraphMemory &) = delete;
+
+    std::pmr::memory_resource *resource();
+    //! returns every chunk to the system at once. Nothing allocated from resource() may be alive anymore.
+    void release();
+    //! destroys the containers, releases the arena and constructs them again from resource().
+    //! They are only constructed after the release, since even an empty container may hold arena memory, e.g. the
+    //! buckets of a std::pmr::unordered_map with MSVC.
+    template <typename... Containers>
+    void reset(Containers &...containers)
+    {
+        (std::destroy_at(&containers), ...);
+        release();
+        (std::construct_at(&containers, resource()), ...);
+    }
+    AllocatorStats stats() const;
+
+  private:
+    CountingResource system_;
+    std::pmr::unsynchronized_pool_resource pools_;
+    CountingResource requests_;
+};
+} // namespace dt::df::editor
@@ -0,0 +1,165 @@
+#include "graph_snapshot.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace dt::df::editor::snapshot
+{
+namespace
+{
+constexpr std::size_t kSectionAlignment = 8;
+
+template <typename T>
+SectionRef writeSection(std::ofstream &out, const std::vector<T> &data)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto offset = static_cast<std::uint64_t>(out.tellp());
+    out.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+    const auto padding = (kSectionAlignment - (data.size() * sizeof(T)) % kSectionAlignment) % kSectionAlignment;
+    constexpr std::array<char, kSectionAlignment> zeros{};
+    out.write(zeros.data(), static_cast<std::streamsize>(padding));
+    return SectionRef{offset, data.size()};
+}
+} // namespace
+
+void SnapshotWriter::addNode(const NodeId id,
+                             const NodeKey &key,
+                             const float x,
+                             const float y,
+                             std::span<const SlotRecord> slots,
+                             std::span<const std::uint8_t> blob)
+{
+    nodes_.emplace_back(NodeRecord{id, internKey(key), x, y, slots_.size(), slots.size(), blobs_.size(), blob.size()});
+    slots_.insert(slots_.end(), slots.begin(), slots.end());
+    blobs_.insert(blobs_.end(), blob.begin(), blob.end());
+}
+
+void SnapshotWriter::addLink(const SlotId from, const SlotId to)
+{
+    links_.emplace_back(LinkRecord{from, to});
+}
+
+std::uint32_t SnapshotWriter::internKey(const NodeKey &key)
+{
+    const auto [key_it, inserted] = key_indices_.try_emplace(key, static_cast<std::uint32_t>(keys_.size()));
+    if (inserted)
+    {
+        keys_.emplace_back(KeyRecord{key_chars_.size(), key.size()});
+        key_chars_.insert(key_chars_.end(), key.begin(), key.end());
+    }
+    return key_it->second;
+}
+
+void SnapshotWriter::write(const std::filesystem::path &file, const int next_vertex_id) const
+{
+    std::ofstream out{file, std::ios::binary | std::ios::trunc};
+    if (!out)
+        throw std::runtime_error("can't open snapshot file for writing");
+
+    Header header{};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.next_vertex_id = next_vertex_id;
+    // reserve the header and patch it once all section offsets are known
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    header.keys = writeSection(out, keys_);
+    header.key_chars = writeSection(out, key_chars_);
+    header.nodes = writeSection(out, nodes_);
+    header.slots = writeSection(out, slots_);
+    header.blobs = writeSection(out, blobs_);
+    header.links = writeSection(out, links_);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!out)
+        throw std::runtime_error("can't write snapshot file");
+}
+
+SnapshotReader::SnapshotReader(const std::filesystem::path &file)
+{
+    if (std::filesystem::file_size(file) < sizeof(Header))
+        throw std::runtime_error("snapshot file is too small");
+    file_ = boost::interprocess::file_mapping{file.string().c_str(), boost::interprocess::read_only};
+    region_ = boost::interprocess::mapped_region{file_, boost::interprocess::read_only};
+    data_ = static_cast<const std::uint8_t *>(region_.get_address());
+    size_ = region_.get_size();
+    validate();
+}
+
+const Header &SnapshotReader::header() const
+{
+    return *reinterpret_cast<const Header *>(data_);
+}
+
+std::span<const NodeRecord> SnapshotReader::nodes() const
+{
+    return section<NodeRecord>(header().nodes);
+}
+
+std::span<const SlotRecord> SnapshotReader::slots(const NodeRecord &node) const
+{
+    return section<SlotRecord>(header().slots).subspan(node.first_slot, node.slot_count);
+}
+
+std::span<const LinkRecord> SnapshotReader::links() const
+{
+    return section<LinkRecord>(header().links);
+}
+
+std::uint32_t SnapshotReader::numKeys() const
+{
+    return static_cast<std::uint32_t>(header().keys.count);
+}
+
+std::string_view SnapshotReader::key(const std::uint32_t key_index) const
+{
+    const auto &key = section<KeyRecord>(header().keys)[key_index];
+    const auto chars = section<char>(header().key_chars);
+    return std::string_view{chars.data() + key.offset, key.size};
+}
+
+std::span<const std::uint8_t> SnapshotReader::blob(const NodeRecord &node) const
+{
+    return section<std::uint8_t>(header().blobs).subspan(node.blob_offset, node.blob_size);
+}
+
+template <typename T>
+std::span<const T> SnapshotReader::section(const SectionRef &ref) const
+{
+    return std::span<const T>{reinterpret_cast<const T *>(data_ + ref.offset), ref.count};
+}
+
+void SnapshotReader::validate() const
+{
+    const auto &head = header();
+    if (head.magic != kMagic)
+        throw std::runtime_error("not a graph snapshot");
+    if (head.version != kVersion)
+        throw std::runtime_error("unsupported snapshot version");
+
+    const auto check_section = [this](const SectionRef &ref, const std::size_t record_size) {
+        if (ref.offset % kSectionAlignment != 0 || ref.offset > size_ || ref.count > (size_ - ref.offset) / record_size)
+            throw std::runtime_error("snapshot section out of bounds");
+    };
+    check_section(head.keys, sizeof(KeyRecord));
+    check_section(head.key_chars, 1);
+    check_section(head.nodes, sizeof(NodeRecord));
+    check_section(head.slots, sizeof(SlotRecord));
+    check_section(head.blobs, 1);
+    check_section(head.links, sizeof(LinkRecord));
+
+    for (const auto &key : section<KeyRecord>(head.keys))
+    {
+        if (key.offset > head.key_chars.count || key.size > head.key_chars.count - key.offset)
+            throw std::runtime_error("snapshot key out of bounds");
+    }
+    for (const auto &node : nodes())
+    {
+        if (node.key_index >= head.keys.count)
+            throw std::runtime_error("snapshot node key out of bounds");
+        if (node.first_slot > head.slots.count || node.slot_count > head.slots.count - node.first_slot)
+            throw std::runtime_error("snapshot node slots out of bounds");
+        if (node.blob_offset > head.blobs.count || node.blob_size > head.blobs.count - node.blob_offset)
+            throw std::runtime_error("snapshot node state out of bounds");
+    }
+}
+} // namespace dt::df::editor::snapshot
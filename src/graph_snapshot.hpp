@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <dt/df/core/types.hpp>
+
+//! binary snapshot of a graph.
+//! The file consists of a header followed by contiguous sections of trivially copyable records. All sections are 8 byte
+//! aligned and written in native byte order, so a memory mapped file can be read in place without parsing.
+namespace dt::df::editor::snapshot
+{
+constexpr std::array<char, 8> kMagic{'D', 'T', 'D', 'F', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kVersion = 1;
+
+struct SectionRef
+{
+    std::uint64_t offset;
+    std::uint64_t count; //! number of records, or bytes for byte sections
+};
+struct Header
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::int32_t next_vertex_id;
+    SectionRef keys;      //! KeyRecord
+    SectionRef key_chars; //! bytes
+    SectionRef nodes;     //! NodeRecord
+    SectionRef slots;     //! SlotRecord
+    SectionRef blobs;     //! bytes. serialized node states
+    SectionRef links;     //! LinkRecord
+};
+struct KeyRecord
+{
+    std::uint64_t offset; //! into key_chars
+    std::uint64_t size;
+};
+struct NodeRecord
+{
+    std::int32_t id;
+    std::uint32_t key_index;
+    float x;
+    float y;
+    std::uint64_t first_slot;
+    std::uint64_t slot_count;
+    std::uint64_t blob_offset; //! into blobs
+    std::uint64_t blob_size;
+};
+struct SlotRecord
+{
+    std::int32_t id;
+    std::uint32_t type; //! SlotType
+};
+struct LinkRecord
+{
+    std::int32_t from;
+    std::int32_t to;
+};
+
+class SnapshotWriter
+{
+  public:
+    void addNode(const NodeId id,
+                 const NodeKey &key,
+                 const float x,
+                 const float y,
+                 std::span<const SlotRecord> slots,
+                 std::span<const std::uint8_t> blob);
+    void addLink(const SlotId from, const SlotId to);
+    //! throws std::runtime_error if the file can't be written
+    void write(const std::filesystem::path &file, const int next_vertex_id) const;
+
+  private:
+    std::uint32_t internKey(const NodeKey &key);
+
+  private:
+    std::unordered_map<NodeKey, std::uint32_t> key_indices_;
+    std::vector<KeyRecord> keys_;
+    std::vector<char> key_chars_;
+    std::vector<NodeRecord> nodes_;
+    std::vector<SlotRecord> slots_;
+    std::vector<std::uint8_t> blobs_;
+    std::vector<LinkRecord> links_;
+};
+
+class SnapshotReader
+{
+  public:
+    //! maps the file and validates all sections. throws std::runtime_error on invalid snapshots.
+    explicit SnapshotReader(const std::filesystem::path &file);
+    const Header &header() const;
+    std::span<const NodeRecord> nodes() const;
+    std::span<const SlotRecord> slots(const NodeRecord &node) const;
+    std::span<const LinkRecord> links() const;
+    std::uint32_t numKeys() const;
+    std::string_view key(const std::uint32_t key_index) const;
+    std::span<const std::uint8_t> blob(const NodeRecord &node) const;
+
+  private:
+    template <typename T>
+    std::span<const T> section(const SectionRef &ref) const;
+    void validate() const;
+
+  private:
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    const std::uint8_t *data_;
+    std::size_t size_;
+};
+} // namespace dt::df::editor::snapshot
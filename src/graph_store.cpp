@@ -0,0 +1,185 @@
+#include "graph_store.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace dt::df::editor
+{
+namespace
+{
+//! the pending edges are scanned on every traversal, so they are limited to max(kMinPendingEdges, sqrt(edges)).
+//! this balances the scan against the O(V + E) rebuild.
+constexpr std::size_t kMinPendingEdges = 64;
+//! removed edges only cost a skipped entry in their rows, the rows are rebuilt once a quarter of them is dead
+constexpr std::size_t kMinReleasedEdges = 1024;
+constexpr VertexDesc kInvalidVertex = std::numeric_limits<VertexDesc>::max();
+
+void buildRows(const std::pmr::vector<VertexDesc> &ends,
+               const std::pmr::vector<std::uint8_t> &alive,
+               const std::size_t num_vertices,
+               std::pmr::vector<std::uint32_t> &offsets,
+               std::pmr::vector<EdgeDesc> &edges)
+{
+    offsets.assign(num_vertices + 1, 0);
+    for (EdgeDesc edge = 0; edge < ends.size(); edge++)
+    {
+        if (alive[edge])
+            offsets[ends[edge] + 1]++;
+    }
+    for (std::size_t vertex = 0; vertex < num_vertices; vertex++)
+        offsets[vertex + 1] += offsets[vertex];
+
+    edges.resize(offsets.back());
+    // every entry moves offsets[v] one further, so that afterwards it holds the end of row v
+    for (EdgeDesc edge = 0; edge < ends.size(); edge++)
+    {
+        if (alive[edge])
+            edges[offsets[ends[edge]]++] = edge;
+    }
+    for (auto vertex = num_vertices; vertex > 0; vertex--)
+        offsets[vertex] = offsets[vertex - 1];
+    offsets[0] = 0;
+}
+} // namespace
+
+GraphStore::GraphStore(std::pmr::memory_resource *resource)
+    : ids_{resource}
+    , parent_ids_{resource}
+    , types_{resource}
+    , sources_{resource}
+    , targets_{resource}
+    , infos_{resource}
+    , alive_{resource}
+    , free_edges_{resource}
+    , out_offsets_{resource}
+    , out_edges_{resource}
+    , in_offsets_{resource}
+    , in_edges_{resource}
+    , pending_edges_{resource}
+    , released_edges_{resource}
+{}
+
+VertexDesc GraphStore::addVertex(const VertexInfo &info)
+{
+    ids_.emplace_back(info.id);
+    parent_ids_.emplace_back(info.parent_id);
+    types_.emplace_back(info.type);
+    return static_cast<VertexDesc>(ids_.size() - 1);
+}
+
+void GraphStore::setVertex(const VertexDesc vertex, const VertexInfo &info)
+{
+    ids_[vertex] = info.id;
+    parent_ids_[vertex] = info.parent_id;
+    types_[vertex] = info.type;
+}
+
+VertexInfo GraphStore::vertex(const VertexDesc vertex) const
+{
+    return VertexInfo{ids_[vertex], parent_ids_[vertex], types_[vertex]};
+}
+
+EdgeDesc GraphStore::addEdge(const VertexDesc from, const VertexDesc to, EdgeInfo &&info)
+{
+    EdgeDesc edge;
+    if (free_edges_.empty())
+    {
+        edge = static_cast<EdgeDesc>(sources_.size());
+        sources_.emplace_back(from);
+        targets_.emplace_back(to);
+        infos_.emplace_back(std::move(info));
+        alive_.emplace_back(1);
+    }
+    else
+    {
+        edge = free_edges_.back();
+        free_edges_.pop_back();
+        sources_[edge] = from;
+        targets_[edge] = to;
+        infos_[edge] = std::move(info);
+        alive_[edge] = 1;
+    }
+    pending_edges_.emplace_back(edge);
+    num_edges_++;
+    return edge;
+}
+
+void GraphStore::removeEdge(const EdgeDesc edge)
+{
+    assert(("edge was already removed", alive_[edge]));
+    alive_[edge] = 0;
+    infos_[edge] = EdgeInfo{-1, RefCon{}};
+    released_edges_.emplace_back(edge);
+    num_edges_--;
+}
+
+std::size_t GraphStore::degree(const VertexDesc vertex) const
+{
+    std::size_t count = 0;
+    forEachOutEdge(vertex, [&count](EdgeDesc) { count++; });
+    forEachInEdge(vertex, [&count](EdgeDesc) { count++; });
+    return count;
+}
+
+void GraphStore::clearVertex(const VertexDesc vertex)
+{
+    clearVertices(std::span{&vertex, 1});
+}
+
+void GraphStore::clearVertices(std::span<const VertexDesc> vertices)
+{
+    std::vector<EdgeDesc> edges;
+    for (const auto vertex : vertices)
+    {
+        forEachOutEdge(vertex, [&edges](const EdgeDesc edge) { edges.emplace_back(edge); });
+        forEachInEdge(vertex, [&edges](const EdgeDesc edge) { edges.emplace_back(edge); });
+    }
+    for (const auto edge : edges)
+    {
+        // self loops and edges between two of the vertices are listed twice
+        if (alive_[edge])
+            removeEdge(edge);
+    }
+}
+
+void GraphStore::compactVertices()
+{
+    std::vector<VertexDesc> remap(ids_.size(), kInvalidVertex);
+    VertexDesc live = 0;
+    for (VertexDesc vertex = 0; vertex < ids_.size(); vertex++)
+    {
+        if (types_[vertex] == VertexType::unused)
+            continue;
+        ids_[live] = ids_[vertex];
+        parent_ids_[live] = parent_ids_[vertex];
+        types_[live] = types_[vertex];
+        remap[vertex] = live++;
+    }
+    ids_.resize(live);
+    parent_ids_.resize(live);
+    types_.resize(live);
+
+    for (EdgeDesc edge = 0; edge < sources_.size(); edge++)
+    {
+        if (!alive_[edge])
+            continue;
+        assert(("edge of a dead vertex", remap[sources_[edge]] != kInvalidVertex));
+        assert(("edge of a dead vertex", remap[targets_[edge]] != kInvalidVertex));
+        sources_[edge] = remap[sources_[edge]];
+        targets_[edge] = remap[targets_[edge]];
+    }
+    rebuildAdjacency();
+}
+
+void GraphStore::rebuildAdjacency() const
+{
+    buildRows(sources_, alive_, ids_.size(), out_offsets_, out_edges_);
+    buildRows(targets_, alive_, ids_.size(), in_offsets_, in_edges_);
+    pending_edges_.clear();
+    free_edges_.insert(free_edges_.end(), released_edges_.begin(), released_edges_.end());
+    released_edges_.clear();
+    max_pending_edges_ = std::max(kMinPendingEdges, static_cast<std::size_t>(std::sqrt(num_edges_)));
+    max_released_edges_ = std::max(kMinReleasedEdges, num_edges_ / 4);
+}
+} // namespace dt::df::editor
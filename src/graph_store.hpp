@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+#include "priv_types.hpp"
+
+namespace dt::df::editor
+{
+//! vertex and edge storage of the graph.
+//! The vertex properties live in parallel arrays and the edges in a dense pool. The adjacency is kept as compressed
+//! rows (CSR) which are rebuilt lazily: removed edges stay in the rows as tombstones and added edges are kept in a
+//! pending list until the next traversal finds too many of either.
+class GraphStore
+{
+  public:
+    explicit GraphStore(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    VertexDesc addVertex(const VertexInfo &info);
+    void setVertex(const VertexDesc vertex, const VertexInfo &info);
+    VertexInfo vertex(const VertexDesc vertex) const;
+    // the accessors are inline since they are on every lookup path
+    int id(const VertexDesc vertex) const
+    {
+        return ids_[vertex];
+    }
+    NodeId parentId(const VertexDesc vertex) const
+    {
+        return parent_ids_[vertex];
+    }
+    VertexType type(const VertexDesc vertex) const
+    {
+        return types_[vertex];
+    }
+    std::size_t numVertices() const
+    {
+        return ids_.size();
+    }
+
+    //! parallel edges are allowed
+    EdgeDesc addEdge(const VertexDesc from, const VertexDesc to, EdgeInfo &&info);
+    //! destroys the payload, which disconnects the link
+    void removeEdge(const EdgeDesc edge);
+    VertexDesc source(const EdgeDesc edge) const
+    {
+        return sources_[edge];
+    }
+    VertexDesc target(const EdgeDesc edge) const
+    {
+        return targets_[edge];
+    }
+    const EdgeInfo &edge(const EdgeDesc edge) const
+    {
+        return infos_[edge];
+    }
+    EdgeInfo &edge(const EdgeDesc edge)
+    {
+        return infos_[edge];
+    }
+    std::size_t numEdges() const
+    {
+        return num_edges_;
+    }
+
+    //! fnc(EdgeDesc) is called for every edge leaving the vertex. fnc must not add or remove edges.
+    template <typename Fnc>
+    void forEachOutEdge(const VertexDesc vertex, Fnc &&fnc) const
+    {
+        forEachEdge(vertex, out_offsets_, out_edges_, sources_, fnc);
+    }
+    //! fnc(EdgeDesc) is called for every edge entering the vertex. fnc must not add or remove edges.
+    template <typename Fnc>
+    void forEachInEdge(const VertexDesc vertex, Fnc &&fnc) const
+    {
+        forEachEdge(vertex, in_offsets_, in_edges_, targets_, fnc);
+    }
+    std::size_t degree(const VertexDesc vertex) const;
+    //! removes every edge leaving or entering the vertex
+    void clearVertex(const VertexDesc vertex);
+    //! same as clearVertex for each vertex, but collects the edges of all of them in one pass
+    void clearVertices(std::span<const VertexDesc> vertices);
+
+    //! drops every vertex of type VertexType::unused. Those must not have edges anymore.
+    //! Edge descriptors stay valid, vertex descriptors are moved down.
+    void compactVertices();
+
+  private:
+    template <typename Fnc>
+    void forEachEdge(const VertexDesc vertex,
+                     const std::pmr::vector<std::uint32_t> &offsets,
+                     const std::pmr::vector<EdgeDesc> &edges,
+                     const std::pmr::vector<VertexDesc> &ends,
+                     Fnc &fnc) const
+    {
+        if (pending_edges_.size() > max_pending_edges_ || released_edges_.size() > max_released_edges_)
+            rebuildAdjacency();
+        if (vertex + 1 < offsets.size())
+        {
+            for (auto i = offsets[vertex]; i < offsets[vertex + 1]; i++)
+            {
+                const auto edge = edges[i];
+                if (alive_[edge])
+                    fnc(edge);
+            }
+        }
+        for (const auto edge : pending_edges_)
+        {
+            if (alive_[edge] && ends[edge] == vertex)
+                fnc(edge);
+        }
+    }
+    void rebuildAdjacency() const;
+
+  private:
+    // vertex properties, indexed by VertexDesc
+    std::pmr::vector<int> ids_;
+    std::pmr::vector<NodeId> parent_ids_;
+    std::pmr::vector<VertexType> types_;
+
+    // edge pool, indexed by EdgeDesc
+    std::pmr::vector<VertexDesc> sources_;
+    std::pmr::vector<VertexDesc> targets_;
+    std::pmr::vector<EdgeInfo> infos_;
+    std::pmr::vector<std::uint8_t> alive_;
+    std::size_t num_edges_ = 0;
+    //! slots which can be reused right away
+    mutable std::pmr::vector<EdgeDesc> free_edges_;
+
+    // compressed rows of the live edges at the last rebuild. the rows of vertex v are [offsets[v], offsets[v + 1]).
+    // free edge slots are only handed out again after a rebuild dropped them from the rows.
+    mutable std::pmr::vector<std::uint32_t> out_offsets_;
+    mutable std::pmr::vector<EdgeDesc> out_edges_;
+    mutable std::pmr::vector<std::uint32_t> in_offsets_;
+    mutable std::pmr::vector<EdgeDesc> in_edges_;
+    //! added since the last rebuild
+    mutable std::pmr::vector<EdgeDesc> pending_edges_;
+    //! removed since the last rebuild, still referenced by the rows
+    mutable std::pmr::vector<EdgeDesc> released_edges_;
+    //! the next traversal rebuilds the rows if one of the lists grew beyond its limit. updated by every rebuild.
+    mutable std::size_t max_pending_edges_ = 0;
+    mutable std::size_t max_released_edges_ = 0;
+};
+} // namespace dt::df::editor
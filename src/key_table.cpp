@@ -0,0 +1,28 @@
+#include "key_table.hpp"
+
+namespace dt::df::editor
+{
+KeyId KeyTable::intern(const std::string &key)
+{
+    const auto [id_it, inserted] = ids_.try_emplace(key, static_cast<KeyId>(keys_.size()));
+    if (inserted)
+        keys_.emplace_back(&id_it->first);
+    return id_it->second;
+}
+
+KeyId KeyTable::find(std::string_view key) const
+{
+    const auto id_it = ids_.find(key);
+    return id_it == ids_.end() ? kInvalidKeyId : id_it->second;
+}
+
+const std::string &KeyTable::key(const KeyId id) const
+{
+    return *keys_[id];
+}
+
+std::size_t KeyTable::size() const
+{
+    return keys_.size();
+}
+} // namespace dt::df::editor
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace dt::df::editor
+{
+using KeyId = std::uint32_t;
+constexpr KeyId kInvalidKeyId = std::numeric_limits<KeyId>::max();
+
+//! interns node or slot keys. Every key gets a dense id in the order of its first registration, so that everything
+//! else can be kept in flat vectors indexed by the id and compared as integers.
+class KeyTable
+{
+  public:
+    //! returns the id of the key and adds it first if it is unknown
+    KeyId intern(const std::string &key);
+    //! kInvalidKeyId if the key was never interned
+    KeyId find(std::string_view key) const;
+    //! stays valid as long as the table
+    const std::string &key(const KeyId id) const;
+    std::size_t size() const;
+
+  private:
+    struct Hash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const
+        {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    std::unordered_map<std::string, KeyId, Hash, std::equal_to<>> ids_;
+    //! the map nodes don't move, so the keys are only stored once
+    std::vector<const std::string *> keys_;
+};
+} // namespace dt::df::editor
@@ -1,95 +1,109 @@
 #include "node_display_tree.hpp"
 
-#include <iostream>
-
 #include <boost/algorithm/string.hpp>
-#include <boost/graph/depth_first_search.hpp>
 namespace dt::df::editor
 {
 
-struct my_visitor : boost::default_dfs_visitor
+NodeDisplayGraph::NodeDisplayGraph(const KeyTable &node_keys)
+    : node_keys_{node_keys}
 {
-    const NodeDisplayDrawFnc &draw_fnc_;
-    mutable int curr_level = 0;
-    explicit my_visitor(const NodeDisplayDrawFnc &draw_fnc)
-        : draw_fnc_{draw_fnc}
-    {}
-    void discover_vertex(const NodeTree::vertex_descriptor &s, const NodeTree &g) const
-    {
-        const auto prev_lvl = curr_level++;
-        draw_fnc_(prev_lvl, curr_level, boost::out_degree(s, g) == 0, g[s].node_key, g[s].display_name);
-    }
-
-    void finish_vertex(const NodeTree::vertex_descriptor &s, const NodeTree &g) const
-    {
-        draw_fnc_(curr_level, curr_level, boost::out_degree(s, g) == 0, g[s].node_key, g[s].display_name);
-        curr_level--;
-    }
-};
-
-NodeDisplayGraph::NodeDisplayGraph()
-{
-    root_node_ = boost::add_vertex({"root", "Nodes"}, node_tree_);
+    tree_nodes_.emplace_back(TreeNode{kInvalidKeyId, "Nodes", {}, {}});
 }
 
-void NodeDisplayGraph::addNode(const std::string &node_key, const std::string &node_name)
+void NodeDisplayGraph::addNode(const KeyId node_key, const std::string &node_name)
 {
     std::vector<std::string> groups;
     boost::split(groups, node_name, boost::is_any_of("/"));
     if (groups.size() == 0)
     {
-        addNodeToGraph(node_key, node_name, root_node_);
+        addNodeToGraph(node_key, node_name, 0);
         return;
     }
 
-    Desc parent = root_node_;
-    for (int i = 0; i < groups.size() - 1; i++)
+    std::size_t parent = 0;
+    for (std::size_t i = 0; i < groups.size() - 1; i++)
     {
-        parent = addNodeToGraph("", groups[i], parent);
+        parent = addNodeToGraph(kInvalidKeyId, groups[i], parent);
     }
     addNodeToGraph(node_key, groups[groups.size() - 1], parent);
 }
 
-NodeDisplayGraph::Desc NodeDisplayGraph::addNodeToGraph(const std::string &node_key,
-                                                        const std::string &node_name,
-                                                        const Desc parent)
+std::size_t NodeDisplayGraph::addNodeToGraph(const KeyId node_key,
+                                             const std::string &node_name,
+                                             const std::size_t parent)
 {
+    dirty_ = true;
     // look if we have already a node with the same name. If yes, return the already existing node
-    for (const auto vd : boost::make_iterator_range(boost::adjacent_vertices(parent, node_tree_)))
+    const auto existing_it = tree_nodes_[parent].child_by_name.find(node_name);
+    if (existing_it != tree_nodes_[parent].child_by_name.end())
     {
-        auto &node = node_tree_[vd];
-        if (node.display_name == node_name)
+        auto &node = tree_nodes_[existing_it->second];
+        if (node.node_key != node_key)
         {
-            if (node.node_key != node_key)
-            {
-                node.node_key = node_key;
-                //! \todo log key change!!
-            }
-            return vd;
+            node.node_key = node_key;
+            //! \todo log key change!!
         }
+        return existing_it->second;
     }
-    const auto desc = boost::add_vertex({node_key, node_name}, node_tree_);
-    boost::add_edge(parent, desc, node_tree_);
-    return desc;
+    const auto index = tree_nodes_.size();
+    tree_nodes_.emplace_back(TreeNode{node_key, node_name, {}, {}});
+    tree_nodes_[parent].children.emplace_back(index);
+    tree_nodes_[parent].child_by_name.emplace(node_name, index);
+    return index;
 }
 
-void NodeDisplayGraph::drawTree(const NodeDisplayDrawFnc &draw_fnc) const
+void NodeDisplayGraph::compile() const
 {
-    /* INDEX MAP CREATION*/
-    std::map<Desc, size_t> i_map;
-    for (auto v : boost::make_iterator_range(boost::vertices(node_tree_)))
+    flat_tree_.clear();
+    flat_tree_.reserve(tree_nodes_.size());
+
+    struct Pending
+    {
+        std::size_t node;
+        std::size_t parent_entry;
+    };
+    std::vector<Pending> stack{{0, 0}};
+    while (!stack.empty())
     {
-        i_map.emplace(v, i_map.size());
+        const auto pending = stack.back();
+        stack.pop_back();
+        const auto &node = tree_nodes_[pending.node];
+        const auto entry = flat_tree_.size();
+        const int level = entry == 0 ? 0 : flat_tree_[pending.parent_entry].level + 1;
+        const auto *node_key = node.node_key != kInvalidKeyId ? &node_keys_.key(node.node_key)
+                               : entry == 0                   ? &root_key_
+                                                              : &group_key_;
+        flat_tree_.emplace_back(
+            FlatEntry{level, node.children.empty(), pending.parent_entry, node_key, &node.display_name});
+        // reversed, so that the children get popped in insertion order
+        for (auto child_it = node.children.rbegin(); child_it != node.children.rend(); ++child_it)
+            stack.emplace_back(Pending{*child_it, entry});
     }
+    dirty_ = false;
+}
 
-    auto ipmap = boost::make_assoc_property_map(i_map);
+void NodeDisplayGraph::drawTree(const NodeDisplayDrawFnc &draw_fnc) const
+{
+    if (dirty_)
+        compile();
 
-    /* COLOR MAP CREATION */
-    std::vector<boost::default_color_type> c_map(boost::num_vertices(node_tree_));
-    auto cpmap = boost::make_iterator_property_map(c_map.begin(), ipmap);
+    // every entry is opened with (level, level + 1) and closed with (level + 1, level + 1) once its subtree is done.
+    for (std::size_t i = 0; i < flat_tree_.size(); i++)
+    {
+        const auto &entry = flat_tree_[i];
+        draw_fnc(entry.level, entry.level + 1, entry.is_leaf, *entry.node_key, *entry.display_name);
 
-    const my_visitor vis{draw_fnc};
-    boost::depth_first_search(node_tree_, boost::visitor(vis).vertex_index_map(ipmap).color_map(cpmap));
+        const int next_level = i + 1 < flat_tree_.size() ? flat_tree_[i + 1].level : 0;
+        auto closing = i;
+        while (flat_tree_[closing].level >= next_level)
+        {
+            const auto &closed = flat_tree_[closing];
+            draw_fnc(closed.level + 1, closed.level + 1, closed.is_leaf, *closed.node_key, *closed.display_name);
+            if (closing == 0)
+                break;
+            closing = closed.parent;
+        }
+    }
 }
 
 } // namespace dt::df::editor
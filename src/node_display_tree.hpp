@@ -1,23 +1,48 @@
 #pragma once
-#include "priv_types.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "dt/df/editor/types.hpp"
+#include "key_table.hpp"
 
 namespace dt::df::editor
 {
+//! tree of the node display names, split into groups at '/'. Compiled into a flat pre-order list for drawing.
 class NodeDisplayGraph
 {
-    using Desc = NodeTree::vertex_descriptor;
-
   public:
-    NodeDisplayGraph();
-    void addNode(const std::string &node_key, const std::string &node_name);
+    //! the node keys are resolved through the table when drawing
+    explicit NodeDisplayGraph(const KeyTable &node_keys);
+    void addNode(const KeyId node_key, const std::string &node_name);
+    //! compiles the tree if a node was added since the last call
     void drawTree(const NodeDisplayDrawFnc &draw_fnc) const;
 
   private:
-    Desc addNodeToGraph(const std::string &node_key, const std::string &node_name, const Desc parent);
+    struct TreeNode
+    {
+        KeyId node_key; //! kInvalidKeyId for the root and the groups
+        std::string display_name;
+        std::vector<std::size_t> children; //! in insertion order
+        std::unordered_map<std::string, std::size_t> child_by_name;
+    };
+    struct FlatEntry
+    {
+        int level;
+        bool is_leaf;
+        std::size_t parent; //! position of the parent entry. the root points to itself.
+        const std::string *node_key;
+        const std::string *display_name;
+    };
+
+    std::size_t addNodeToGraph(const KeyId node_key, const std::string &node_name, const std::size_t parent);
+    void compile() const;
 
   private:
-    NodeTree node_tree_;
-    NodeTree::vertex_descriptor root_node_;
+    const KeyTable &node_keys_;
+    const std::string root_key_{"root"};
+    const std::string group_key_;
+    std::vector<TreeNode> tree_nodes_; //! index 0 is the root
+    mutable std::vector<FlatEntry> flat_tree_;
+    mutable bool dirty_ = true;
 };
 } // namespace dt::df::editor
@@ -0,0 +1,258 @@
+#include "node_search_index.hpp"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+namespace dt::df::editor
+{
+namespace
+{
+constexpr int kSubstringScore = 2000;
+constexpr int kSubsequenceScore = 1000;
+//! substrings further back lose at most this much, so that they still rank above every subsequence
+constexpr int kMaxPositionPenalty = 100;
+//! candidates which only share trigrams with the query score hits * kTrigramHitScore, always below a subsequence
+constexpr int kTrigramHitScore = 10;
+//! a subsequence may spread over at most this many characters per query character
+constexpr std::size_t kMaxSubsequenceSpread = 3;
+//! the clock is only read after this many candidates
+constexpr std::size_t kBudgetCheckInterval = 64;
+constexpr std::uint32_t kNoEntry = std::numeric_limits<std::uint32_t>::max();
+
+char toLower(const char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+std::string toLower(std::string_view text)
+{
+    std::string lower(text.size(), '\0');
+    std::transform(text.begin(), text.end(), lower.begin(), [](const char c) { return toLower(c); });
+    return lower;
+}
+
+std::uint32_t packTrigram(const char *chars)
+{
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(chars[0])) << 16 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(chars[1])) << 8 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(chars[2]));
+}
+
+//! start of a group, the name, the key or a camel case word
+bool isWordStart(const std::string &text, const std::size_t pos)
+{
+    if (pos == 0)
+        return true;
+    const auto prev = static_cast<unsigned char>(text[pos - 1]);
+    const auto curr = static_cast<unsigned char>(text[pos]);
+    switch (prev)
+    {
+    case '/':
+    case ' ':
+    case '_':
+    case '-':
+    case '.':
+    case ':':
+    case '\n':
+        return true;
+    default:
+        return std::isupper(curr) && std::islower(prev);
+    }
+}
+} // namespace
+
+void NodeSearchIndex::add(const KeyId key_id, const NodeKey &key, const std::string &display_name)
+{
+    auto text = display_name + '\n' + key;
+    auto lower_text = toLower(text);
+    if (key_id >= entry_by_key_.size())
+        entry_by_key_.resize(key_id + 1, kNoEntry);
+    auto &entry_id = entry_by_key_[key_id];
+    if (entry_id == kNoEntry)
+    {
+        entry_id = static_cast<std::uint32_t>(entries_.size());
+        entries_.emplace_back(Entry{display_name, std::move(text), std::move(lower_text)});
+    }
+    else
+    {
+        auto &entry = entries_[entry_id];
+        if (entry.display_name == display_name)
+            return;
+        // the trigrams of the old name stay in the postings, the ranking checks every candidate anyway
+        entry.display_name = display_name;
+        entry.text = std::move(text);
+        entry.lower_text = std::move(lower_text);
+    }
+    indexTrigrams(entry_id);
+}
+
+void NodeSearchIndex::indexTrigrams(const std::uint32_t entry_id)
+{
+    const auto &lower_text = entries_[entry_id].lower_text;
+    for (std::size_t i = 0; i + 3 <= lower_text.size(); i++)
+    {
+        auto &posting = postings_[packTrigram(lower_text.data() + i)];
+        // ids are appended in ascending order, only a re-registered entry has to be sorted in
+        if (!posting.empty() && posting.back() >= entry_id)
+        {
+            const auto pos_it = std::lower_bound(posting.begin(), posting.end(), entry_id);
+            if (pos_it == posting.end() || *pos_it != entry_id)
+                posting.insert(pos_it, entry_id);
+        }
+        else
+            posting.emplace_back(entry_id);
+    }
+}
+
+int NodeSearchIndex::score(std::string_view lower_query, const Entry &entry)
+{
+    const auto &lower_text = entry.lower_text;
+    const auto name_end = entry.display_name.size();
+    const auto leaf_begin = entry.display_name.find_last_of('/') + 1; // npos + 1 == 0
+
+    const auto substring_pos = lower_text.find(lower_query);
+    if (substring_pos != std::string::npos)
+    {
+        int result = kSubstringScore;
+        if (isWordStart(entry.text, substring_pos))
+            result += 300;
+        if (substring_pos >= leaf_begin && substring_pos < name_end)
+            result += 200;
+        if (substring_pos == leaf_begin && lower_query.size() == name_end - leaf_begin)
+            result += 500;
+        return result - static_cast<int>(std::min<std::size_t>(substring_pos, kMaxPositionPenalty));
+    }
+
+    // greedy subsequence match which prefers consecutive characters and word starts.
+    // single characters and pairs only match as substring, they would be found in nearly every entry otherwise.
+    if (lower_query.size() < 3)
+        return 0;
+    int result = kSubsequenceScore;
+    std::size_t first_match = std::string::npos;
+    std::size_t text_pos = 0;
+    std::size_t prev_match = std::string::npos;
+    for (const char c : lower_query)
+    {
+        const auto match = lower_text.find(c, text_pos);
+        if (match == std::string::npos)
+            return 0;
+        result += 10;
+        if (prev_match != std::string::npos && match == prev_match + 1)
+            result += 15;
+        else if (isWordStart(entry.text, match))
+            result += 20;
+        else
+            result -= static_cast<int>(std::min<std::size_t>(match - text_pos, 10));
+        if (first_match == std::string::npos)
+            first_match = match;
+        prev_match = match;
+        text_pos = match + 1;
+    }
+    if (prev_match - first_match >= kMaxSubsequenceSpread * lower_query.size())
+        return 0;
+    return std::clamp(result, kSubsequenceScore, kSubstringScore - kMaxPositionPenalty - 1);
+}
+
+std::vector<NodeSearchMatch> NodeSearchIndex::search(std::string_view query,
+                                                     const std::size_t max_results,
+                                                     const std::chrono::microseconds budget) const
+{
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    const auto lower_query = toLower(query);
+    if (lower_query.empty() || max_results == 0)
+        return {};
+
+    std::vector<std::uint32_t> candidates;
+    std::vector<std::uint16_t> trigram_hits;
+    std::size_t min_hits = 0;
+    if (lower_query.size() < 3)
+    {
+        candidates.resize(entries_.size());
+        for (std::uint32_t i = 0; i < candidates.size(); i++)
+            candidates[i] = i;
+    }
+    else
+    {
+        std::vector<Trigram> query_trigrams;
+        for (std::size_t i = 0; i + 3 <= lower_query.size(); i++)
+            query_trigrams.emplace_back(packTrigram(lower_query.data() + i));
+        std::sort(query_trigrams.begin(), query_trigrams.end());
+        query_trigrams.erase(std::unique(query_trigrams.begin(), query_trigrams.end()), query_trigrams.end());
+        // a typo breaks up to three trigrams, so half of them are enough to become a candidate
+        min_hits = (query_trigrams.size() + 1) / 2;
+
+        trigram_hits.resize(entries_.size());
+        for (const auto trigram : query_trigrams)
+        {
+            const auto posting_it = postings_.find(trigram);
+            if (posting_it == postings_.end())
+                continue;
+            for (const auto entry_id : posting_it->second)
+            {
+                if (trigram_hits[entry_id]++ == 0)
+                    candidates.emplace_back(entry_id);
+            }
+        }
+    }
+
+    std::vector<std::pair<int, std::uint32_t>> ranked;
+    std::size_t num_scored = 0;
+    const auto out_of_time = [&num_scored, deadline] {
+        return ++num_scored % kBudgetCheckInterval == 0 && std::chrono::steady_clock::now() > deadline;
+    };
+    bool timed_out = false;
+    for (const auto entry_id : candidates)
+    {
+        if (!trigram_hits.empty() && trigram_hits[entry_id] < min_hits)
+            continue;
+        if ((timed_out = out_of_time()))
+            break;
+        auto entry_score = score(lower_query, entries_[entry_id]);
+        if (entry_score == 0 && !trigram_hits.empty())
+            entry_score = trigram_hits[entry_id] * kTrigramHitScore;
+        if (entry_score > 0)
+            ranked.emplace_back(entry_score, entry_id);
+    }
+    // abbreviations like "mlt" share no trigram with their target. Look for subsequences in the remaining time.
+    if (!trigram_hits.empty() && !timed_out && ranked.empty())
+    {
+        for (std::uint32_t entry_id = 0; entry_id < entries_.size(); entry_id++)
+        {
+            if (trigram_hits[entry_id] >= min_hits)
+                continue;
+            if (out_of_time())
+                break;
+            const auto entry_score = score(lower_query, entries_[entry_id]);
+            if (entry_score > 0)
+                ranked.emplace_back(entry_score, entry_id);
+        }
+    }
+
+    const auto num_results = std::min(max_results, ranked.size());
+    std::partial_sort(
+        ranked.begin(), ranked.begin() + num_results, ranked.end(), [this](const auto &lhs, const auto &rhs) {
+            if (lhs.first != rhs.first)
+                return lhs.first > rhs.first;
+            const auto &lhs_name = entries_[lhs.second].display_name;
+            const auto &rhs_name = entries_[rhs.second].display_name;
+            if (lhs_name.size() != rhs_name.size())
+                return lhs_name.size() < rhs_name.size();
+            return lhs.second < rhs.second;
+        });
+
+    std::vector<NodeSearchMatch> matches;
+    matches.reserve(num_results);
+    for (std::size_t i = 0; i < num_results; i++)
+    {
+        const auto &entry = entries_[ranked[i].second];
+        matches.emplace_back(
+            NodeSearchMatch{entry.text.substr(entry.display_name.size() + 1), entry.display_name, ranked[i].first});
+    }
+    return matches;
+}
+
+std::size_t NodeSearchIndex::size() const
+{
+    return entries_.size();
+}
+} // namespace dt::df::editor
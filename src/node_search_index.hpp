@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "dt/df/editor/types.hpp"
+#include "key_table.hpp"
+
+namespace dt::df::editor
+{
+//! trigram index over the keys and display paths of the registered node types.
+//! The trigrams only narrow down the candidates, which are then ranked by a fuzzy subsequence match.
+class NodeSearchIndex
+{
+  public:
+    //! adding a known key again replaces its display name
+    void add(const KeyId key_id, const NodeKey &key, const std::string &display_name);
+    //! case insensitive. Queries shorter than three characters scan all node types.
+    //! Stops ranking new candidates once the budget is used up and returns the best matches found so far.
+    std::vector<NodeSearchMatch> search(std::string_view query,
+                                        const std::size_t max_results,
+                                        const std::chrono::microseconds budget) const;
+    std::size_t size() const;
+
+  private:
+    struct Entry
+    {
+        std::string display_name;
+        std::string text;       //! "<display name>\n<key>"
+        std::string lower_text; //! text in lower case, same length
+    };
+    using Trigram = std::uint32_t;
+
+    void indexTrigrams(const std::uint32_t entry_id);
+    static int score(std::string_view lower_query, const Entry &entry);
+
+  private:
+    std::vector<Entry> entries_;
+    //! indexed by the key id
+    std::vector<std::uint32_t> entry_by_key_;
+    //! sorted entry ids containing the trigram
+    std::unordered_map<Trigram, std::vector<std::uint32_t>> postings_;
+};
+} // namespace dt::df::editor
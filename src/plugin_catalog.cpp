@@ -0,0 +1,114 @@
+#include "plugin_catalog.hpp"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace dt::df::editor
+{
+namespace
+{
+constexpr int kCatalogVersion = 2;
+} // namespace
+
+PluginCatalog PluginCatalog::load(const std::filesystem::path &file)
+{
+    using json = nlohmann::json;
+
+    PluginCatalog catalog;
+    std::ifstream input{file};
+    if (!input)
+        return catalog;
+    try
+    {
+        const auto catalog_json = json::parse(input);
+        if (catalog_json.at("version").get<int>() != kCatalogVersion)
+            return catalog;
+        for (const auto &plugin_json : catalog_json.at("plugins"))
+        {
+            CatalogPlugin plugin{plugin_json.at("name").get<std::string>(),
+                                 plugin_json.at("slots").get<std::vector<SlotKey>>(),
+                                 {},
+                                 {}};
+            for (const auto &node_json : plugin_json.at("nodes"))
+                plugin.nodes.emplace_back(
+                    CatalogNode{node_json.at("key").get<NodeKey>(), node_json.at("name").get<std::string>()});
+            for (const auto &file_json : plugin_json.at("files"))
+                plugin.files.emplace_back(CatalogFile{file_json.at("name").get<std::string>(),
+                                                      file_json.at("time").get<std::int64_t>(),
+                                                      file_json.at("size").get<std::uint64_t>()});
+            catalog.plugins_.emplace_back(std::move(plugin));
+        }
+    }
+    catch (const json::exception &)
+    {
+        return PluginCatalog{};
+    }
+    return catalog;
+}
+
+void PluginCatalog::save(const std::filesystem::path &file) const
+{
+    using json = nlohmann::json;
+
+    json plugins_json = json::array();
+    for (const auto &plugin : plugins_)
+    {
+        json nodes_json = json::array();
+        for (const auto &node : plugin.nodes)
+            nodes_json.emplace_back(json{{"key", node.key}, {"name", node.display_name}});
+        json files_json = json::array();
+        for (const auto &file : plugin.files)
+            files_json.emplace_back(json{{"name", file.name}, {"time", file.write_time}, {"size", file.size}});
+        plugins_json.emplace_back(json{
+            {"name", plugin.name}, {"slots", plugin.slot_keys}, {"nodes", nodes_json}, {"files", files_json}});
+    }
+
+    std::ofstream o(file);
+    o << json{{"version", kCatalogVersion}, {"plugins", std::move(plugins_json)}} << std::endl;
+}
+
+const CatalogPlugin *PluginCatalog::find(const std::string &plugin_name) const
+{
+    auto plugin_it = std::find_if(
+        plugins_.begin(), plugins_.end(), [&plugin_name](const auto &plugin) { return plugin.name == plugin_name; });
+    return plugin_it != plugins_.end() ? &*plugin_it : nullptr;
+}
+
+void PluginCatalog::set(CatalogPlugin &&plugin)
+{
+    auto plugin_it = std::find_if(
+        plugins_.begin(), plugins_.end(), [&plugin](const auto &entry) { return entry.name == plugin.name; });
+    if (plugin_it != plugins_.end())
+        *plugin_it = std::move(plugin);
+    else
+        plugins_.emplace_back(std::move(plugin));
+}
+
+std::vector<CatalogFile> PluginCatalog::pluginFiles(const std::filesystem::path &plugin_dir,
+                                                    const std::string &plugin_name)
+{
+    std::vector<CatalogFile> files;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator{plugin_dir, ec})
+    {
+        if (!entry.is_regular_file(ec) || entry.path().stem() != plugin_name)
+            continue;
+        const auto write_time = entry.last_write_time(ec);
+        const auto size = entry.file_size(ec);
+        if (ec)
+            continue;
+        files.emplace_back(CatalogFile{entry.path().filename().string(),
+                                       static_cast<std::int64_t>(write_time.time_since_epoch().count()),
+                                       static_cast<std::uint64_t>(size)});
+    }
+    std::sort(files.begin(), files.end(), [](const auto &a, const auto &b) { return a.name < b.name; });
+    return files;
+}
+
+std::size_t PluginCatalog::retain(const std::vector<std::string> &plugin_names)
+{
+    return std::erase_if(plugins_, [&plugin_names](const auto &plugin) {
+        return std::find(plugin_names.begin(), plugin_names.end(), plugin.name) == plugin_names.end();
+    });
+}
+} // namespace dt::df::editor
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <dt/df/core/types.hpp>
+
+namespace dt::df::editor
+{
+struct CatalogNode
+{
+    NodeKey key;
+    std::string display_name;
+};
+//! a file of a plugin as it was when the plugin was described
+struct CatalogFile
+{
+    std::string name;
+    std::int64_t write_time;
+    std::uint64_t size;
+    bool operator==(const CatalogFile &) const = default;
+};
+struct CatalogPlugin
+{
+    std::string name;
+    std::vector<SlotKey> slot_keys;
+    std::vector<CatalogNode> nodes;
+    //! sorted by name
+    std::vector<CatalogFile> files;
+};
+
+//! cached list of the factories each plugin registers. Lets the editor show the palette without loading the plugins.
+class PluginCatalog
+{
+  public:
+    //! returns an empty catalog if the file doesn't exist or can't be parsed
+    static PluginCatalog load(const std::filesystem::path &file);
+    void save(const std::filesystem::path &file) const;
+
+    const CatalogPlugin *find(const std::string &plugin_name) const;
+    void set(CatalogPlugin &&plugin);
+    //! drops all plugins which aren't in plugin_names. returns the number of dropped plugins.
+    std::size_t retain(const std::vector<std::string> &plugin_names);
+
+    //! the library and metadata files of the plugin, i.e. all files in the directory named after the plugin.
+    //! A plugin was replaced if these don't match the ones of its catalog entry anymore.
+    static std::vector<CatalogFile> pluginFiles(const std::filesystem::path &plugin_dir, const std::string &plugin_name);
+
+  private:
+    std::vector<CatalogPlugin> plugins_;
+};
+} // namespace dt::df::editor
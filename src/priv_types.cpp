@@ -1,7 +1,26 @@
 #include "priv_types.hpp"
+#include <utility>
 
 namespace dt::df::editor
 {
+RefCon::RefCon(boost::signals2::connection &&connection)
+    : connection{std::move(connection)}
+{}
+
+RefCon::RefCon(RefCon &&other) noexcept
+    : connection{std::exchange(other.connection, boost::signals2::connection{})}
+{}
+
+RefCon &RefCon::operator=(RefCon &&other) noexcept
+{
+    if (this != &other)
+    {
+        connection.disconnect();
+        connection = std::exchange(other.connection, boost::signals2::connection{});
+    }
+    return *this;
+}
+
 RefCon::~RefCon()
 {
     connection.disconnect();
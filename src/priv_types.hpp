@@ -1,8 +1,8 @@
 #pragma once
 #include <dt/df/core/types.hpp>
 #include <atomic>
-#include <boost/graph/adjacency_list.hpp>
 #include <boost/signals2.hpp>
+#include <cstdint>
 #include <memory>
 #include <shared_mutex>
 
@@ -12,7 +12,8 @@ enum class VertexType
 {
     node,
     input,
-    output
+    output,
+    unused //! dead vertex waiting in the free list for reuse
 };
 struct VertexInfo
 {
@@ -21,31 +22,41 @@ struct VertexInfo
     VertexType type;
 };
 
+//! owns the signal connection of a link and disconnects it on destruction. Movable to live inside the edge pool.
 struct RefCon
 {
     boost::signals2::connection connection;
+    RefCon() = default;
+    explicit RefCon(boost::signals2::connection &&connection);
+    RefCon(RefCon &&other) noexcept;
+    RefCon &operator=(RefCon &&other) noexcept;
+    RefCon(const RefCon &) = delete;
+    RefCon &operator=(const RefCon &) = delete;
     ~RefCon();
 };
 struct EdgeInfo
 {
     EdgeId id;
-    std::shared_ptr<RefCon> connection;
+    RefCon connection; //! empty for the edges between a node and its slots
 };
-struct EdgeInfo_t
-{
-    typedef boost::edge_property_tag kind;
-};
-
-using EdgeProperty = boost::property<EdgeInfo_t, EdgeInfo>;
-using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::bidirectionalS, VertexInfo, EdgeProperty>;
 
-using VertexDesc = Graph::vertex_descriptor;
-using EdgeDesc = Graph::edge_descriptor;
+//! position inside the vertex arrays of GraphStore
+using VertexDesc = std::uint32_t;
+//! position inside the edge pool of GraphStore. stays valid until the edge is removed.
+using EdgeDesc = std::uint32_t;
 
-struct NodeDisplayVertex
+//! flat copy of a link between an output and an input slot. Kept contiguous for the per frame link submission.
+struct LinkInfo
+{
+    EdgeId id;
+    SlotId from;
+    SlotId to;
+    NodeId from_node;
+    NodeId to_node;
+};
+struct LinkRef
 {
-    std::string node_key; //! might be empty if a group
-    std::string display_name;
+    EdgeDesc edge;
+    std::size_t link_pos; //! position inside the flat link list
 };
-using NodeTree = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, NodeDisplayVertex>;
 } // namespace dt::df::editor
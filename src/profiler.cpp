@@ -0,0 +1,176 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dt::df::editor
+{
+std::string_view timingScopeName(const TimingScope scope)
+{
+    switch (scope)
+    {
+    case TimingScope::editor_render:
+        return "Editor::render";
+    case TimingScope::apply_commands:
+        return "apply commands";
+    case TimingScope::editor_graph:
+        return "node editor";
+    case TimingScope::editor_interaction:
+        return "interaction";
+    case TimingScope::render_nodes:
+        return "renderNodes";
+    case TimingScope::render_links:
+        return "renderLinks";
+    case TimingScope::add_edge:
+        return "addEdge";
+    case TimingScope::remove_edge:
+        return "removeEdge";
+    case TimingScope::remove_nodes:
+        return "removeNodes";
+    case TimingScope::count:
+        break;
+    }
+    return "unknown";
+}
+
+void SampleRing::push(const float micros)
+{
+    samples_[next_] = micros;
+    next_ = (next_ + 1) % kCapacity;
+    count_ = std::min<std::uint32_t>(count_ + 1, kCapacity);
+}
+
+TimingStats SampleRing::stats() const
+{
+    if (count_ == 0)
+        return TimingStats{};
+    // reused, the overlay asks for the stats of every scope and the slowest nodes each frame
+    thread_local std::array<float, kCapacity> sorted;
+    std::copy_n(samples_.begin(), count_, sorted.begin());
+    const auto end = sorted.begin() + count_;
+
+    TimingStats stats{};
+    stats.samples = count_;
+    stats.min_us = *std::min_element(sorted.begin(), end);
+    float sum = 0.f;
+    std::for_each(sorted.begin(), end, [&sum](const float sample) { sum += sample; });
+    stats.avg_us = sum / static_cast<float>(count_);
+    const auto p99_index = static_cast<std::size_t>(std::ceil(0.99 * count_)) - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + p99_index, end);
+    stats.p99_us = sorted[p99_index];
+    return stats;
+}
+
+void NodeTimings::push(const float micros)
+{
+    buckets_[bucketIndex(micros)]++;
+    if (++counted_ >= kDecayCount)
+    {
+        counted_ = 0;
+        for (auto &bucket : buckets_)
+        {
+            bucket /= 2;
+            counted_ += bucket;
+        }
+    }
+    samples_++;
+    average_ += (micros - average_) / static_cast<float>(std::min(samples_, kAverageWindow));
+}
+
+TimingStats NodeTimings::stats() const
+{
+    if (counted_ == 0)
+        return TimingStats{};
+    TimingStats stats{};
+    stats.samples = samples_;
+    stats.avg_us = average_;
+    const auto first_bucket =
+        std::find_if(buckets_.begin(), buckets_.end(), [](const std::uint16_t count) { return count > 0; });
+    stats.min_us = bucketMicros(static_cast<std::size_t>(first_bucket - buckets_.begin()));
+    // the upper bound of the bucket which holds the p99 sample
+    const auto p99_count = static_cast<std::uint32_t>(std::ceil(0.99 * counted_));
+    std::uint32_t cumulated = 0;
+    for (std::size_t bucket = 0; bucket < kBuckets; bucket++)
+    {
+        cumulated += buckets_[bucket];
+        if (cumulated >= p99_count)
+        {
+            stats.p99_us = bucketMicros(bucket + 1);
+            break;
+        }
+    }
+    return stats;
+}
+
+float NodeTimings::averageMicros() const
+{
+    return average_;
+}
+
+std::size_t NodeTimings::bucketIndex(const float micros)
+{
+    if (!(micros > 0.f))
+        return 0;
+    const auto index = static_cast<int>(std::floor(std::log2(micros) * kBucketsPerOctave)) -
+                       kFirstBucketExponent * kBucketsPerOctave;
+    return static_cast<std::size_t>(std::clamp(index, 0, static_cast<int>(kBuckets) - 1));
+}
+
+float NodeTimings::bucketMicros(const std::size_t bucket)
+{
+    return std::exp2(static_cast<float>(bucket) / kBucketsPerOctave + kFirstBucketExponent);
+}
+
+void Profiler::record(const TimingScope scope, const float micros)
+{
+    scopes_[static_cast<std::size_t>(scope)].push(micros);
+}
+
+void Profiler::recordNode(const NodeId id, const float micros)
+{
+    nodes_[id].push(micros);
+}
+
+TimingStats Profiler::stats(const TimingScope scope) const
+{
+    if (scope == TimingScope::count)
+        return TimingStats{};
+    return scopes_[static_cast<std::size_t>(scope)].stats();
+}
+
+TimingStats Profiler::nodeStats(const NodeId id) const
+{
+    auto node_it = nodes_.find(id);
+    return node_it == nodes_.end() ? TimingStats{} : node_it->second.stats();
+}
+
+std::vector<std::pair<NodeId, TimingStats>> Profiler::slowestNodes(const std::size_t max_nodes) const
+{
+    // called every frame while the overlay is open, so only the running averages of all nodes are compared
+    std::vector<std::pair<float, const std::pair<const NodeId, NodeTimings> *>> candidates;
+    candidates.reserve(nodes_.size());
+    for (const auto &node : nodes_)
+        candidates.emplace_back(node.second.averageMicros(), &node);
+    const auto count = std::min(max_nodes, candidates.size());
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + count,
+                      candidates.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+
+    std::vector<std::pair<NodeId, TimingStats>> nodes;
+    nodes.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+        nodes.emplace_back(candidates[i].second->first, candidates[i].second->second.stats());
+    return nodes;
+}
+
+void Profiler::removeNode(const NodeId id)
+{
+    nodes_.erase(id);
+}
+
+void Profiler::clear()
+{
+    scopes_ = {};
+    nodes_.clear();
+}
+} // namespace dt::df::editor
@@ -0,0 +1,129 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <dt/df/core/types.hpp>
+#include "dt/df/editor/types.hpp"
+
+#ifdef DTDFEDITOR_PROFILING
+#define DTDF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DTDF_PROFILE_CONCAT(a, b) DTDF_PROFILE_CONCAT_IMPL(a, b)
+//! times the rest of the enclosing block. profiler isn't evaluated if profiling is disabled.
+#define DTDF_PROFILE_SCOPE(profiler, scope)                                                                            \
+    const ::dt::df::editor::ScopedTiming DTDF_PROFILE_CONCAT(dtdf_timing_, __LINE__)                                   \
+    {                                                                                                                  \
+        profiler, scope                                                                                                \
+    }
+#define DTDF_PROFILE_NODE(profiler, node_id) DTDF_PROFILE_SCOPE(profiler, static_cast<::dt::df::NodeId>(node_id))
+//! same as DTDF_PROFILE_SCOPE through the public DataFlowGraph::profileScope
+#define DTDF_PROFILE_GRAPH(graph, scope)                                                                               \
+    const auto DTDF_PROFILE_CONCAT(dtdf_timing_, __LINE__) = (graph).profileScope(scope)
+#else
+#define DTDF_PROFILE_SCOPE(profiler, scope)
+#define DTDF_PROFILE_NODE(profiler, node_id)
+#define DTDF_PROFILE_GRAPH(graph, scope)
+#endif
+
+namespace dt::df::editor
+{
+std::string_view timingScopeName(const TimingScope scope);
+
+//! the last kCapacity samples in microseconds. with fewer than 100 samples the p99 would just be the maximum, so the
+//! ring keeps enough to let it skip the worst few outliers.
+class SampleRing
+{
+  public:
+    static constexpr std::size_t kCapacity = 512;
+    void push(const float micros);
+    TimingStats stats() const;
+
+  private:
+    std::array<float, kCapacity> samples_{};
+    std::uint32_t next_ = 0;
+    std::uint32_t count_ = 0;
+};
+
+//! summary of the render times of one node. graphs have up to 100k nodes, so this stays at a few bytes instead of a
+//! sample history: the times are counted in quarter octave buckets, which makes min and p99 exact to about 19%.
+//! The counts are halved once kDecayCount samples were counted, so that old frames fade out.
+class NodeTimings
+{
+  public:
+    void push(const float micros);
+    TimingStats stats() const;
+    //! running average over roughly the last kAverageWindow samples
+    float averageMicros() const;
+
+  private:
+    //! 2^-2 us up to 2^16 us
+    static constexpr std::size_t kBuckets = 72;
+    static constexpr int kBucketsPerOctave = 4;
+    static constexpr int kFirstBucketExponent = -2;
+    static constexpr std::uint32_t kDecayCount = 512;
+    static constexpr std::uint32_t kAverageWindow = 64;
+    static std::size_t bucketIndex(const float micros);
+    //! lower bound of the bucket in microseconds
+    static float bucketMicros(const std::size_t bucket);
+
+  private:
+    std::array<std::uint16_t, kBuckets> buckets_{};
+    //! sum of buckets_
+    std::uint32_t counted_ = 0;
+    std::uint32_t samples_ = 0;
+    float average_ = 0.f;
+};
+
+//! collects the timings of the hot paths. only the render thread records.
+class Profiler
+{
+  public:
+    void record(const TimingScope scope, const float micros);
+    void recordNode(const NodeId id, const float micros);
+    TimingStats stats(const TimingScope scope) const;
+    TimingStats nodeStats(const NodeId id) const;
+    //! sorted by the average time, slowest first. only the stats of the returned nodes are computed.
+    std::vector<std::pair<NodeId, TimingStats>> slowestNodes(const std::size_t max_nodes) const;
+    void removeNode(const NodeId id);
+    void clear();
+
+  private:
+    std::array<SampleRing, static_cast<std::size_t>(TimingScope::count)> scopes_;
+    std::unordered_map<NodeId, NodeTimings> nodes_;
+};
+
+class ScopedTiming
+{
+  public:
+    ScopedTiming(Profiler &profiler, const TimingScope scope)
+        : profiler_{profiler}
+        , scope_{scope}
+        , begin_{std::chrono::steady_clock::now()}
+    {}
+    ScopedTiming(Profiler &profiler, const NodeId node)
+        : profiler_{profiler}
+        , node_{node}
+        , begin_{std::chrono::steady_clock::now()}
+    {}
+    ScopedTiming(const ScopedTiming &) = delete;
+    ScopedTiming &operator=(const ScopedTiming &) = delete;
+    ~ScopedTiming()
+    {
+        const auto micros =
+            std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - begin_).count();
+        if (node_ >= 0)
+            profiler_.recordNode(node_, micros);
+        else
+            profiler_.record(scope_, micros);
+    }
+
+  private:
+    Profiler &profiler_;
+    TimingScope scope_ = TimingScope::count;
+    NodeId node_ = -1;
+    std::chrono::steady_clock::time_point begin_;
+};
+} // namespace dt::df::editor
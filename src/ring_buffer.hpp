@@ -0,0 +1,404 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace dt::df::editor
+{
+//! what the blocking push and pop calls do once the queue stays full or empty
+enum class WaitStrategy
+{
+    //! keeps the thread busy and yields. lowest latency, burns a core.
+    yield,
+    //! spins and yields for a short while and then sleeps until the other side made progress.
+    spin_then_park
+};
+
+namespace detail
+{
+inline constexpr std::size_t kCacheLineSize = 64;
+inline constexpr int kSpinIterations = 256;
+inline constexpr int kYieldIterations = 64;
+
+inline void cpuRelax() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+//! waits until value differs from observed. parked counts the sleeping threads, so that wake() only needs the
+//! notify when somebody actually sleeps.
+inline void awaitChange(const std::atomic<std::size_t> &value,
+                        const std::size_t observed,
+                        const WaitStrategy strategy,
+                        std::atomic<std::uint32_t> &parked)
+{
+    for (int i = 0; i < kSpinIterations; i++)
+    {
+        if (value.load(std::memory_order_acquire) != observed)
+            return;
+        cpuRelax();
+    }
+    for (int i = 0; strategy == WaitStrategy::yield || i < kYieldIterations; i++)
+    {
+        if (value.load(std::memory_order_acquire) != observed)
+            return;
+        std::this_thread::yield();
+    }
+    parked.fetch_add(1, std::memory_order_seq_cst);
+    value.wait(observed, std::memory_order_seq_cst);
+    parked.fetch_sub(1, std::memory_order_relaxed);
+}
+
+//! has to be called after value was changed.
+inline void wake(std::atomic<std::size_t> &value, const WaitStrategy strategy, std::atomic<std::uint32_t> &parked)
+{
+    if (strategy != WaitStrategy::spin_then_park)
+        return;
+    // pairs with the fetch_add in awaitChange: either the waiter sees the new value or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked.load(std::memory_order_relaxed) > 0)
+        value.notify_all();
+}
+
+inline std::size_t ringCapacity(const std::size_t requested)
+{
+    return std::bit_ceil(std::max<std::size_t>(requested, 2));
+}
+} // namespace detail
+
+//! bounded lock-free FIFO for exactly one producer and one consumer thread.
+//! the capacity is rounded up to the next power of two. batch calls publish all items with a single store.
+template <typename T>
+class SpscRing
+{
+  public:
+    explicit SpscRing(const std::size_t capacity, const WaitStrategy wait_strategy = WaitStrategy::spin_then_park)
+        : mask_{detail::ringCapacity(capacity) - 1}
+        , buffer_{std::make_unique<T[]>(mask_ + 1)}
+        , wait_strategy_{wait_strategy}
+    {}
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // producer side
+
+    bool tryPush(const T &item)
+    {
+        return tryEmplace(item);
+    }
+    //! item is only moved from if the push succeeded
+    bool tryPush(T &&item)
+    {
+        return tryEmplace(std::move(item));
+    }
+    void push(T item)
+    {
+        while (!tryEmplace(std::move(item)))
+            detail::awaitChange(head_, head_cache_, wait_strategy_, parked_);
+    }
+    //! pushes as many items as fit and returns their count
+    std::size_t tryPush(std::span<const T> items)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const auto count = std::min(items.size(), freeSlots(tail));
+        for (std::size_t i = 0; i < count; i++)
+            buffer_[(tail + i) & mask_] = items[i];
+        if (count > 0)
+            publishTail(tail + count);
+        return count;
+    }
+    void push(std::span<const T> items)
+    {
+        for (;;)
+        {
+            items = items.subspan(tryPush(items));
+            if (items.empty())
+                return;
+            detail::awaitChange(head_, head_cache_, wait_strategy_, parked_);
+        }
+    }
+
+    // consumer side
+
+    bool tryPop(T &item)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (usedSlots(head) == 0)
+            return false;
+        item = std::move(buffer_[head & mask_]);
+        publishHead(head + 1);
+        return true;
+    }
+    T pop()
+    {
+        T item;
+        while (!tryPop(item))
+            detail::awaitChange(tail_, tail_cache_, wait_strategy_, parked_);
+        return item;
+    }
+    //! pops up to items.size() items and returns their count
+    std::size_t tryPop(std::span<T> items)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        const auto count = std::min(items.size(), usedSlots(head));
+        for (std::size_t i = 0; i < count; i++)
+            items[i] = std::move(buffer_[(head + i) & mask_]);
+        if (count > 0)
+            publishHead(head + count);
+        return count;
+    }
+    //! waits for at least one item and pops up to items.size() items
+    std::size_t pop(std::span<T> items)
+    {
+        if (items.empty())
+            return 0;
+        for (;;)
+        {
+            if (const auto count = tryPop(items); count > 0)
+                return count;
+            detail::awaitChange(tail_, tail_cache_, wait_strategy_, parked_);
+        }
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+    //! only exact if neither side is active
+    std::size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+  private:
+    template <typename U>
+    bool tryEmplace(U &&item)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (freeSlots(tail) == 0)
+            return false;
+        buffer_[tail & mask_] = std::forward<U>(item);
+        publishTail(tail + 1);
+        return true;
+    }
+    std::size_t freeSlots(const std::size_t tail)
+    {
+        if (tail - head_cache_ > mask_)
+            head_cache_ = head_.load(std::memory_order_acquire);
+        return mask_ + 1 - (tail - head_cache_);
+    }
+    std::size_t usedSlots(const std::size_t head)
+    {
+        if (tail_cache_ == head)
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+        return tail_cache_ - head;
+    }
+    void publishTail(const std::size_t tail)
+    {
+        tail_.store(tail, std::memory_order_release);
+        detail::wake(tail_, wait_strategy_, parked_);
+    }
+    void publishHead(const std::size_t head)
+    {
+        head_.store(head, std::memory_order_release);
+        detail::wake(head_, wait_strategy_, parked_);
+    }
+
+  private:
+    const std::size_t mask_;
+    const std::unique_ptr<T[]> buffer_;
+    const WaitStrategy wait_strategy_;
+    //! owned by the consumer
+    alignas(detail::kCacheLineSize) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_{0};
+    //! owned by the producer
+    alignas(detail::kCacheLineSize) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_{0};
+    alignas(detail::kCacheLineSize) std::atomic<std::uint32_t> parked_{0};
+};
+
+//! bounded lock-free FIFO for any number of producers and consumers (Vyukov's sequence-per-cell queue).
+//! every item is claimed with its own CAS, the batch calls are a convenience loop around the single ones.
+template <typename T>
+class MpmcRing
+{
+  public:
+    explicit MpmcRing(const std::size_t capacity, const WaitStrategy wait_strategy = WaitStrategy::spin_then_park)
+        : mask_{detail::ringCapacity(capacity) - 1}
+        , cells_{std::make_unique<Cell[]>(mask_ + 1)}
+        , wait_strategy_{wait_strategy}
+    {
+        for (std::size_t i = 0; i <= mask_; i++)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    MpmcRing(const MpmcRing &) = delete;
+    MpmcRing &operator=(const MpmcRing &) = delete;
+
+    bool tryPush(const T &item)
+    {
+        WaitPoint wait_point;
+        return tryEmplace(item, wait_point);
+    }
+    //! item is only moved from if the push succeeded
+    bool tryPush(T &&item)
+    {
+        WaitPoint wait_point;
+        return tryEmplace(std::move(item), wait_point);
+    }
+    void push(T item)
+    {
+        WaitPoint wait_point;
+        while (!tryEmplace(std::move(item), wait_point))
+            detail::awaitChange(*wait_point.sequence, wait_point.observed, wait_strategy_, parked_);
+    }
+    //! pushes items until the queue is full and returns their count
+    std::size_t tryPush(std::span<const T> items)
+    {
+        std::size_t count = 0;
+        while (count < items.size() && tryPush(items[count]))
+            count++;
+        return count;
+    }
+    void push(std::span<const T> items)
+    {
+        for (const auto &item : items)
+            push(item);
+    }
+
+    bool tryPop(T &item)
+    {
+        WaitPoint wait_point;
+        return tryTake(item, wait_point);
+    }
+    T pop()
+    {
+        T item;
+        WaitPoint wait_point;
+        while (!tryTake(item, wait_point))
+            detail::awaitChange(*wait_point.sequence, wait_point.observed, wait_strategy_, parked_);
+        return item;
+    }
+    //! pops up to items.size() items and returns their count
+    std::size_t tryPop(std::span<T> items)
+    {
+        std::size_t count = 0;
+        while (count < items.size() && tryPop(items[count]))
+            count++;
+        return count;
+    }
+    //! waits for at least one item and pops up to items.size() items
+    std::size_t pop(std::span<T> items)
+    {
+        if (items.empty())
+            return 0;
+        items[0] = pop();
+        return 1 + tryPop(items.subspan(1));
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+    //! only exact if no thread is active
+    std::size_t size() const
+    {
+        const auto dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        const auto enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+    //! the cell a blocked thread has to wait on
+    struct WaitPoint
+    {
+        const std::atomic<std::size_t> *sequence = nullptr;
+        std::size_t observed = 0;
+    };
+
+    template <typename U>
+    bool tryEmplace(U &&item, WaitPoint &wait_point)
+    {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto &cell = cells_[pos & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::forward<U>(item);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    detail::wake(cell.sequence, wait_strategy_, parked_);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // the cell still holds the item of the previous round
+                wait_point = WaitPoint{&cell.sequence, sequence};
+                return false;
+            }
+            else
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool tryTake(T &item, WaitPoint &wait_point)
+    {
+        auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto &cell = cells_[pos & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    item = std::move(cell.value);
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    detail::wake(cell.sequence, wait_strategy_, parked_);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                wait_point = WaitPoint{&cell.sequence, sequence};
+                return false;
+            }
+            else
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    const std::size_t mask_;
+    const std::unique_ptr<Cell[]> cells_;
+    const WaitStrategy wait_strategy_;
+    alignas(detail::kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(detail::kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+    alignas(detail::kCacheLineSize) std::atomic<std::uint32_t> parked_{0};
+};
+} // namespace dt::df::editor
@@ -0,0 +1,32 @@
+#include "slot_compatibility.hpp"
+
+namespace dt::df::editor
+{
+void SlotCompatibility::build(const std::size_t key_count, const CanConnectFnc &can_connect)
+{
+    key_count_ = key_count;
+    words_per_row_ = (key_count + kWordBits - 1) / kWordBits;
+    bits_.assign(key_count_ * words_per_row_, 0);
+    for (std::size_t from = 0; from < key_count_; from++)
+    {
+        auto *row = bits_.data() + from * words_per_row_;
+        for (std::size_t to = 0; to < key_count_; to++)
+        {
+            if (can_connect(static_cast<KeyId>(from), static_cast<KeyId>(to)))
+                row[to / kWordBits] |= Word{1} << (to % kWordBits);
+        }
+    }
+}
+
+std::size_t SlotCompatibility::keyCount() const
+{
+    return key_count_;
+}
+
+void SlotCompatibility::clear()
+{
+    key_count_ = 0;
+    words_per_row_ = 0;
+    bits_.clear();
+}
+} // namespace dt::df::editor
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "key_table.hpp"
+
+namespace dt::df::editor
+{
+//! bit matrix over the slot key ids. a set bit (from, to) means an output of key from can be linked to an input of key
+//! to.
+class SlotCompatibility
+{
+  public:
+    using CanConnectFnc = std::function<bool(const KeyId from, const KeyId to)>;
+
+    //! asks can_connect once for every pair of keys
+    void build(const std::size_t key_count, const CanConnectFnc &can_connect);
+    //! keys which were interned after the last build are not compatible to anything
+    bool canConnect(const KeyId from, const KeyId to) const
+    {
+        if (from >= key_count_ || to >= key_count_)
+            return false;
+        const auto bit = static_cast<std::size_t>(from) * words_per_row_ * kWordBits + to;
+        return (bits_[bit / kWordBits] >> (bit % kWordBits)) & 1u;
+    }
+    std::size_t keyCount() const;
+    void clear();
+
+  private:
+    using Word = std::uint64_t;
+    static constexpr std::size_t kWordBits = 64;
+
+    std::size_t key_count_ = 0;
+    //! rows are padded to whole words
+    std::size_t words_per_row_ = 0;
+    std::vector<Word> bits_;
+};
+} // namespace dt::df::editor
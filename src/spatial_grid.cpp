@@ -0,0 +1,121 @@
+#include "spatial_grid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dt::df::editor
+{
+NodeSpatialGrid::NodeSpatialGrid(float cell_size)
+    : cell_size_{cell_size}
+{}
+
+void NodeSpatialGrid::update(const NodeId id, const NodeRect &rect)
+{
+    const auto range = cellRange(rect);
+    auto [entry_it, inserted] = entries_.try_emplace(id, Entry{rect, range});
+    if (inserted)
+    {
+        insertCells(id, range);
+        return;
+    }
+    entry_it->second.rect = rect;
+    if (entry_it->second.cells == range)
+        return;
+    eraseCells(id, entry_it->second.cells);
+    insertCells(id, range);
+    entry_it->second.cells = range;
+}
+
+void NodeSpatialGrid::remove(const NodeId id)
+{
+    auto entry_it = entries_.find(id);
+    if (entry_it == entries_.end())
+        return;
+    eraseCells(id, entry_it->second.cells);
+    entries_.erase(entry_it);
+}
+
+void NodeSpatialGrid::clear()
+{
+    cells_.clear();
+    entries_.clear();
+}
+
+bool NodeSpatialGrid::contains(const NodeId id) const
+{
+    return entries_.contains(id);
+}
+
+const NodeRect *NodeSpatialGrid::rect(const NodeId id) const
+{
+    auto entry_it = entries_.find(id);
+    return entry_it != entries_.end() ? &entry_it->second.rect : nullptr;
+}
+
+void NodeSpatialGrid::query(const NodeRect &area, std::vector<NodeId> &result) const
+{
+    const auto range = cellRange(area);
+    for (int x = range.min_x; x <= range.max_x; x++)
+    {
+        for (int y = range.min_y; y <= range.max_y; y++)
+        {
+            auto cell_it = cells_.find(cellKey(x, y));
+            if (cell_it == cells_.end())
+                continue;
+            for (const auto &cell_entry : cell_it->second)
+            {
+                // a node spanning multiple cells is only reported by the first cell which is inside the query
+                if (x != std::max(cell_entry.min_x, range.min_x) || y != std::max(cell_entry.min_y, range.min_y))
+                    continue;
+                const auto &rect = entries_.at(cell_entry.id).rect;
+                if (rect.x <= area.x + area.width && area.x <= rect.x + rect.width && rect.y <= area.y + area.height &&
+                    area.y <= rect.y + rect.height)
+                    result.emplace_back(cell_entry.id);
+            }
+        }
+    }
+}
+
+std::size_t NodeSpatialGrid::size() const
+{
+    return entries_.size();
+}
+
+NodeSpatialGrid::CellRange NodeSpatialGrid::cellRange(const NodeRect &rect) const
+{
+    return CellRange{static_cast<int>(std::floor(rect.x / cell_size_)),
+                     static_cast<int>(std::floor(rect.y / cell_size_)),
+                     static_cast<int>(std::floor((rect.x + rect.width) / cell_size_)),
+                     static_cast<int>(std::floor((rect.y + rect.height) / cell_size_))};
+}
+
+NodeSpatialGrid::CellKey NodeSpatialGrid::cellKey(const int x, const int y)
+{
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+void NodeSpatialGrid::insertCells(const NodeId id, const CellRange &range)
+{
+    for (int x = range.min_x; x <= range.max_x; x++)
+    {
+        for (int y = range.min_y; y <= range.max_y; y++)
+            cells_[cellKey(x, y)].emplace_back(CellEntry{id, range.min_x, range.min_y});
+    }
+}
+
+void NodeSpatialGrid::eraseCells(const NodeId id, const CellRange &range)
+{
+    for (int x = range.min_x; x <= range.max_x; x++)
+    {
+        for (int y = range.min_y; y <= range.max_y; y++)
+        {
+            auto cell_it = cells_.find(cellKey(x, y));
+            if (cell_it == cells_.end())
+                continue;
+            auto &cell = cell_it->second;
+            std::erase_if(cell, [id](const CellEntry &entry) { return entry.id == id; });
+            if (cell.empty())
+                cells_.erase(cell_it);
+        }
+    }
+}
+} // namespace dt::df::editor
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <dt/df/core/types.hpp>
+
+namespace dt::df::editor
+{
+struct NodeRect
+{
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+//! uniform grid over the node rectangles in grid space. Used to find the nodes which intersect the visible canvas.
+class NodeSpatialGrid
+{
+  public:
+    explicit NodeSpatialGrid(float cell_size = 512.f);
+    //! inserts the node or moves it if it is already known
+    void update(const NodeId id, const NodeRect &rect);
+    void remove(const NodeId id);
+    void clear();
+    bool contains(const NodeId id) const;
+    const NodeRect *rect(const NodeId id) const;
+    //! appends every node which intersects the area to result. each node is reported once.
+    void query(const NodeRect &area, std::vector<NodeId> &result) const;
+    std::size_t size() const;
+
+  private:
+    struct CellRange
+    {
+        int min_x;
+        int min_y;
+        int max_x;
+        int max_y;
+        bool operator==(const CellRange &) const = default;
+    };
+    struct Entry
+    {
+        NodeRect rect;
+        CellRange cells;
+    };
+    struct CellEntry
+    {
+        NodeId id;
+        //! first cell of the node. used to report nodes spanning multiple cells only once
+        int min_x;
+        int min_y;
+    };
+    using CellKey = std::uint64_t;
+
+    CellRange cellRange(const NodeRect &rect) const;
+    static CellKey cellKey(const int x, const int y);
+    void insertCells(const NodeId id, const CellRange &range);
+    void eraseCells(const NodeId id, const CellRange &range);
+
+  private:
+    float cell_size_;
+    std::unordered_map<CellKey, std::vector<CellEntry>> cells_;
+    std::unordered_map<NodeId, Entry> entries_;
+};
+} // namespace dt::df::editor
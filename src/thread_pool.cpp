@@ -0,0 +1,113 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+namespace dt::df::editor
+{
+namespace
+{
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local std::size_t current_worker_index = 0;
+} // namespace
+
+ThreadPool::ThreadPool(unsigned int num_threads)
+{
+    // hardware_concurrency may return 0 if it can't be determined
+    num_threads = std::max(num_threads, 1u);
+    queues_.reserve(num_threads);
+    for (unsigned int i = 0; i < num_threads; i++)
+        queues_.emplace_back(std::make_unique<WorkerQueue>());
+    workers_.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; i++)
+        workers_.emplace_back([this, i](std::stop_token stop_token) { workerLoop(stop_token, i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    for (auto &worker : workers_)
+        worker.request_stop();
+    tasks_available_.notify_all();
+    // the jthreads are joined by their destructors
+}
+
+std::size_t ThreadPool::size() const
+{
+    return workers_.size();
+}
+
+void ThreadPool::post(std::function<void()> &&task)
+{
+    const auto queue_index = current_pool == this
+                                 ? current_worker_index
+                                 : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        // counted first, so that the worker which takes the task can't decrement below zero
+        std::lock_guard lock{sleep_mutex_};
+        num_queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        auto &queue = *queues_[queue_index];
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.emplace_back(std::move(task));
+    }
+    tasks_available_.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    // threads outside of the pool start at the first queue. trySteal covers all others.
+    const auto worker_index = current_pool == this ? current_worker_index : 0;
+    std::function<void()> task;
+    if (!tryPop(worker_index, task) && !trySteal(worker_index, task))
+        return false;
+    num_queued_.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+bool ThreadPool::tryPop(const std::size_t worker_index, std::function<void()> &task)
+{
+    auto &queue = *queues_[worker_index];
+    std::lock_guard lock{queue.mutex};
+    if (queue.tasks.empty())
+        return false;
+    // newest first, its data is most likely still in the cache
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::trySteal(const std::size_t worker_index, std::function<void()> &task)
+{
+    for (std::size_t i = 1; i < queues_.size(); i++)
+    {
+        auto &queue = *queues_[(worker_index + i) % queues_.size()];
+        std::unique_lock lock{queue.mutex, std::try_to_lock};
+        if (!lock || queue.tasks.empty())
+            continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(std::stop_token stop_token, const std::size_t worker_index)
+{
+    current_pool = this;
+    current_worker_index = worker_index;
+    while (true)
+    {
+        std::function<void()> task;
+        if (tryPop(worker_index, task) || trySteal(worker_index, task))
+        {
+            num_queued_.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            continue;
+        }
+        std::unique_lock lock{sleep_mutex_};
+        // a failed try_lock while stealing can leave tasks behind, so the counter is the source of truth
+        if (!tasks_available_.wait(lock, stop_token, [this] { return num_queued_.load(std::memory_order_relaxed) > 0; }))
+            return;
+    }
+}
+} // namespace dt::df::editor
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dt::df::editor
+{
+//! every worker owns a task deque. tasks which are posted from a worker go to the back of its own deque and are
+//! taken from there again, idle workers steal from the front of the other deques.
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(unsigned int num_threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    template <typename Fnc>
+    std::future<std::invoke_result_t<Fnc>> submit(Fnc &&fnc)
+    {
+        // std::function needs a copyable target, packaged_task isn't
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Fnc>()>>(std::forward<Fnc>(fnc));
+        auto result = task->get_future();
+        post([task] { (*task)(); });
+        return result;
+    }
+    //! fire and forget. the task must not throw.
+    void post(std::function<void()> &&task);
+    //! runs one queued task on the calling thread. returns false if there was none.
+    //! lets a thread which waits for pool tasks help instead of blocking a worker, or deadlocking on a single one.
+    bool runPendingTask();
+    std::size_t size() const;
+
+  private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    bool tryPop(const std::size_t worker_index, std::function<void()> &task);
+    bool trySteal(const std::size_t worker_index, std::function<void()> &task);
+    void workerLoop(std::stop_token stop_token, const std::size_t worker_index);
+
+  private:
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::atomic<std::size_t> next_queue_{0};
+    //! tasks which were posted but not yet taken. only incremented while holding sleep_mutex_.
+    std::atomic<std::size_t> num_queued_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable_any tasks_available_;
+    std::vector<std::jthread> workers_;
+};
+} // namespace dt::df::editor
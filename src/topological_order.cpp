@@ -0,0 +1,201 @@
+#include "topological_order.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace dt::df::editor
+{
+namespace
+{
+constexpr std::size_t kMinCompactionPositions = 1024;
+} // namespace
+
+void TopologicalOrder::addNode(const NodeId id)
+{
+    const auto position = static_cast<std::uint32_t>(nodes_by_position_.size());
+    if (!entries_.try_emplace(id, Entry{position, 0, {}, {}}).second)
+        return;
+    nodes_by_position_.emplace_back(id);
+}
+
+void TopologicalOrder::removeNode(const NodeId id)
+{
+    auto entry_it = entries_.find(id);
+    if (entry_it == entries_.end())
+        return;
+    for (const auto &[successor, _] : entry_it->second.successors)
+        entries_.at(successor).predecessors.erase(id);
+    for (const auto &[predecessor, _] : entry_it->second.predecessors)
+        entries_.at(predecessor).successors.erase(id);
+    nodes_by_position_[entry_it->second.position] = -1;
+    entries_.erase(entry_it);
+
+    free_positions_++;
+    if (free_positions_ >= kMinCompactionPositions && free_positions_ > entries_.size())
+        compact();
+}
+
+bool TopologicalOrder::addDependency(const NodeId from, const NodeId to)
+{
+    if (from == to)
+        return false;
+    auto from_it = entries_.find(from);
+    auto to_it = entries_.find(to);
+    if (from_it == entries_.end() || to_it == entries_.end())
+        return true;
+    auto &from_entry = from_it->second;
+    auto &to_entry = to_it->second;
+
+    if (auto successor_it = from_entry.successors.find(to); successor_it != from_entry.successors.end())
+    {
+        successor_it->second++;
+        to_entry.predecessors[from]++;
+        return true;
+    }
+
+    if (to_entry.position < from_entry.position)
+    {
+        // only the nodes between the two positions can be affected
+        epoch_++;
+        forward_.clear();
+        backward_.clear();
+        if (!searchForward(to, from, from_entry.position))
+            return false;
+        searchBackward(from, to_entry.position);
+        reorder();
+    }
+    from_entry.successors.emplace(to, 1);
+    to_entry.predecessors.emplace(from, 1);
+    return true;
+}
+
+void TopologicalOrder::removeDependency(const NodeId from, const NodeId to)
+{
+    auto from_it = entries_.find(from);
+    auto to_it = entries_.find(to);
+    if (from_it == entries_.end() || to_it == entries_.end())
+        return;
+    // removing a dependency never invalidates the order
+    const auto release = [](std::unordered_map<NodeId, std::uint32_t> &links, const NodeId id) {
+        if (auto link_it = links.find(id); link_it != links.end() && --link_it->second == 0)
+            links.erase(link_it);
+    };
+    release(from_it->second.successors, to);
+    release(to_it->second.predecessors, from);
+}
+
+void TopologicalOrder::clear()
+{
+    entries_.clear();
+    nodes_by_position_.clear();
+    free_positions_ = 0;
+}
+
+std::vector<NodeId> TopologicalOrder::order() const
+{
+    std::vector<NodeId> nodes;
+    nodes.reserve(entries_.size());
+    std::copy_if(nodes_by_position_.begin(), nodes_by_position_.end(), std::back_inserter(nodes), [](const NodeId id) {
+        return id >= 0;
+    });
+    return nodes;
+}
+
+std::uint32_t TopologicalOrder::position(const NodeId id) const
+{
+    return entries_.at(id).position;
+}
+
+std::size_t TopologicalOrder::numPredecessors(const NodeId id) const
+{
+    return entries_.at(id).predecessors.size();
+}
+
+bool TopologicalOrder::searchForward(const NodeId start, const NodeId target, const std::uint32_t upper_bound)
+{
+    stack_.assign(1, start);
+    entries_.at(start).mark = epoch_;
+    while (!stack_.empty())
+    {
+        const auto id = stack_.back();
+        stack_.pop_back();
+        forward_.emplace_back(id);
+        for (const auto &[successor, _] : entries_.at(id).successors)
+        {
+            if (successor == target)
+                return false;
+            auto &entry = entries_.at(successor);
+            if (entry.mark != epoch_ && entry.position < upper_bound)
+            {
+                entry.mark = epoch_;
+                stack_.emplace_back(successor);
+            }
+        }
+    }
+    return true;
+}
+
+void TopologicalOrder::searchBackward(const NodeId start, const std::uint32_t lower_bound)
+{
+    stack_.assign(1, start);
+    entries_.at(start).mark = epoch_;
+    while (!stack_.empty())
+    {
+        const auto id = stack_.back();
+        stack_.pop_back();
+        backward_.emplace_back(id);
+        for (const auto &[predecessor, _] : entries_.at(id).predecessors)
+        {
+            auto &entry = entries_.at(predecessor);
+            if (entry.mark != epoch_ && entry.position > lower_bound)
+            {
+                entry.mark = epoch_;
+                stack_.emplace_back(predecessor);
+            }
+        }
+    }
+}
+
+void TopologicalOrder::reorder()
+{
+    // everything which leads to "from" moves in front of everything which is reachable from "to".
+    // both groups keep their relative order and reuse the positions they had before.
+    const auto by_position = [this](const NodeId lhs, const NodeId rhs) {
+        return entries_.at(lhs).position < entries_.at(rhs).position;
+    };
+    std::sort(backward_.begin(), backward_.end(), by_position);
+    std::sort(forward_.begin(), forward_.end(), by_position);
+
+    positions_.clear();
+    for (const auto id : backward_)
+        positions_.emplace_back(entries_.at(id).position);
+    for (const auto id : forward_)
+        positions_.emplace_back(entries_.at(id).position);
+    std::sort(positions_.begin(), positions_.end());
+
+    std::size_t next = 0;
+    for (const auto &group : {std::cref(backward_), std::cref(forward_)})
+    {
+        for (const auto id : group.get())
+        {
+            const auto position = positions_[next++];
+            entries_.at(id).position = position;
+            nodes_by_position_[position] = id;
+        }
+    }
+}
+
+void TopologicalOrder::compact()
+{
+    std::uint32_t position = 0;
+    for (const auto id : nodes_by_position_)
+    {
+        if (id < 0)
+            continue;
+        entries_.at(id).position = position;
+        nodes_by_position_[position++] = id;
+    }
+    nodes_by_position_.resize(position);
+    free_positions_ = 0;
+}
+} // namespace dt::df::editor
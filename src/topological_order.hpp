@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <dt/df/core/types.hpp>
+
+namespace dt::df::editor
+{
+//! dynamic topological order of the nodes (Pearce-Kelly). a new dependency only reorders the nodes between its two
+//! ends and dependencies which would close a cycle are rejected.
+class TopologicalOrder
+{
+  public:
+    void addNode(const NodeId id);
+    void removeNode(const NodeId id);
+    //! from has to come before to. returns false and leaves everything untouched if this would close a cycle.
+    //! several links between the same nodes are counted.
+    bool addDependency(const NodeId from, const NodeId to);
+    void removeDependency(const NodeId from, const NodeId to);
+    void clear();
+    //! every node comes after all nodes it depends on
+    std::vector<NodeId> order() const;
+
+    // read access for ExecutionSchedule. positions are in topological order but may contain holes.
+    std::size_t numPositions() const
+    {
+        return nodes_by_position_.size();
+    }
+    //! -1 if the position is free
+    NodeId nodeAt(const std::uint32_t position) const
+    {
+        return nodes_by_position_[position];
+    }
+    std::uint32_t position(const NodeId id) const;
+    //! number of distinct nodes the node depends on
+    std::size_t numPredecessors(const NodeId id) const;
+    //! fnc(NodeId) is called once for every distinct node which depends on the node
+    template <typename Fnc>
+    void forEachSuccessor(const NodeId id, Fnc &&fnc) const
+    {
+        for (const auto &[successor, _] : entries_.at(id).successors)
+            fnc(successor);
+    }
+
+  private:
+    struct Entry
+    {
+        std::uint32_t position;
+        //! visited in the search with this epoch
+        std::uint32_t mark;
+        //! node id to number of links
+        std::unordered_map<NodeId, std::uint32_t> successors;
+        std::unordered_map<NodeId, std::uint32_t> predecessors;
+    };
+    bool searchForward(const NodeId start, const NodeId target, const std::uint32_t upper_bound);
+    void searchBackward(const NodeId start, const std::uint32_t lower_bound);
+    void reorder();
+    void compact();
+
+  private:
+    std::unordered_map<NodeId, Entry> entries_;
+    //! -1 for positions of removed nodes
+    std::vector<NodeId> nodes_by_position_;
+    std::size_t free_positions_ = 0;
+    std::uint32_t epoch_ = 0;
+    // reused by every search
+    std::vector<NodeId> stack_;
+    std::vector<NodeId> forward_;
+    std::vector<NodeId> backward_;
+    std::vector<std::uint32_t> positions_;
+};
+} // namespace dt::df::editor
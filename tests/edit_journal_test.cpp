@@ -0,0 +1,138 @@
+#include <array>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "edit_journal.hpp"
+#include "test_files.hpp"
+
+using namespace dt::df;
+using namespace dt::df::editor;
+using namespace dt::df::editor::test;
+
+namespace
+{
+//! the replayed records with copies of their key and state, which only live as long as the replay
+struct ReplayedRecord
+{
+    EditJournal::Record record;
+    std::string key;
+    std::vector<std::uint8_t> state;
+};
+
+std::vector<ReplayedRecord> replayAll(const std::filesystem::path &file)
+{
+    std::vector<ReplayedRecord> records;
+    const auto count = EditJournal::replay(file, [&records](const EditJournal::Record &record) {
+        records.emplace_back(
+            ReplayedRecord{record, std::string{record.key}, {record.state.begin(), record.state.end()}});
+    });
+    REQUIRE(count == records.size());
+    return records;
+}
+
+constexpr std::array<std::uint8_t, 4> kState{0x81, 0xa1, 0x61, 0x01};
+
+//! writes one record of every op and returns the file size after each of them
+std::vector<std::uintmax_t> writeEveryOp(const std::filesystem::path &file)
+{
+    std::vector<std::uintmax_t> record_ends;
+    EditJournal journal{file, true};
+    const auto recorded = [&] {
+        journal.flush();
+        record_ends.emplace_back(std::filesystem::file_size(file));
+    };
+    journal.recordAddNode(1, "math/add", kState, 10.f, -20.f);
+    recorded();
+    journal.recordRegisterSlot(1, 2, SlotType::output);
+    recorded();
+    journal.recordAddEdge(2, 5);
+    recorded();
+    journal.recordMoveNode(1, 30.f, 40.f);
+    recorded();
+    journal.recordRemoveEdge(2, 5);
+    recorded();
+    journal.recordUnregisterSlot(1, 2);
+    recorded();
+    journal.recordRemoveNode(1);
+    recorded();
+    return record_ends;
+}
+} // namespace
+
+TEST_CASE("the journal replays every record in order", "[journal]")
+{
+    const TempFile file{"dtdfeditor_journal_roundtrip.journal"};
+    writeEveryOp(file.path());
+
+    const auto records = replayAll(file.path());
+    REQUIRE(records.size() == 7);
+
+    const auto &add_node = records[0];
+    CHECK(add_node.record.op == JournalOp::add_node);
+    CHECK(add_node.record.node == 1);
+    CHECK(add_node.record.x == 10.f);
+    CHECK(add_node.record.y == -20.f);
+    CHECK(add_node.key == "math/add");
+    CHECK(add_node.state == std::vector<std::uint8_t>(kState.begin(), kState.end()));
+
+    CHECK(records[1].record.op == JournalOp::register_slot);
+    CHECK(records[1].record.from == 2);
+    CHECK(records[1].record.slot_type == SlotType::output);
+    CHECK(records[2].record.op == JournalOp::add_edge);
+    CHECK(records[2].record.from == 2);
+    CHECK(records[2].record.to == 5);
+    CHECK(records[3].record.op == JournalOp::move_node);
+    CHECK(records[3].record.x == 30.f);
+    CHECK(records[3].record.y == 40.f);
+    CHECK(records[4].record.op == JournalOp::remove_edge);
+    CHECK(records[5].record.op == JournalOp::unregister_slot);
+    CHECK(records[6].record.op == JournalOp::remove_node);
+    CHECK(records[6].record.node == 1);
+
+    // reopening without truncating appends
+    {
+        EditJournal journal{file.path(), false};
+        journal.recordRemoveNode(3);
+    }
+    const auto appended = replayAll(file.path());
+    REQUIRE(appended.size() == 8);
+    CHECK(appended.back().record.node == 3);
+}
+
+TEST_CASE("the journal replay stops at a torn record", "[journal]")
+{
+    const TempFile file{"dtdfeditor_journal_torn.journal"};
+    const auto record_ends = writeEveryOp(file.path());
+    const auto data = readFile(file.path());
+    REQUIRE(data.size() == record_ends.back());
+
+    // a crash can cut the file anywhere. only the records which were written completely are replayed.
+    for (std::size_t size = 0; size <= data.size(); size++)
+    {
+        writeFile(file.path(), std::vector<char>(data.begin(), data.begin() + size));
+        std::size_t complete_records = 0;
+        while (complete_records < record_ends.size() && record_ends[complete_records] <= size)
+            complete_records++;
+        CAPTURE(size);
+        CHECK(replayAll(file.path()).size() == complete_records);
+    }
+}
+
+TEST_CASE("the journal replay stops at a record with a wrong checksum", "[journal]")
+{
+    const TempFile file{"dtdfeditor_journal_corrupt.journal"};
+    const auto record_ends = writeEveryOp(file.path());
+    auto data = readFile(file.path());
+
+    // the last byte of the add_edge record. the records after it are intact but can't be trusted anymore.
+    data[record_ends[2] - 1] ^= 0x40;
+    writeFile(file.path(), data);
+    CHECK(replayAll(file.path()).size() == 2);
+}
+
+TEST_CASE("a missing journal replays nothing", "[journal]")
+{
+    const TempFile file{"dtdfeditor_journal_missing.journal"};
+    CHECK(EditJournal::replay(file.path(), [](const EditJournal::Record &) { FAIL("no record expected"); }) == 0);
+}
@@ -0,0 +1,158 @@
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "graph_snapshot.hpp"
+#include "test_files.hpp"
+
+using namespace dt::df;
+using namespace dt::df::editor;
+using namespace dt::df::editor::test;
+
+namespace
+{
+template <typename T>
+void patch(std::vector<char> &data, const std::size_t offset, const T &value)
+{
+    std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+//! three nodes linked in a chain. the first and the last node share their key.
+void writeTestSnapshot(const std::filesystem::path &file)
+{
+    snapshot::SnapshotWriter writer;
+    const std::array<snapshot::SlotRecord, 2> source_slots{snapshot::SlotRecord{1, 1}, snapshot::SlotRecord{2, 1}};
+    const std::array<std::uint8_t, 3> source_state{1, 2, 3};
+    writer.addNode(0, "source", 10.f, 20.f, source_slots, source_state);
+    const std::array<snapshot::SlotRecord, 2> filter_slots{snapshot::SlotRecord{4, 0}, snapshot::SlotRecord{5, 1}};
+    writer.addNode(3, "filter", -5.f, 0.5f, filter_slots, {});
+    const std::array<snapshot::SlotRecord, 1> sink_slots{snapshot::SlotRecord{7, 0}};
+    const std::array<std::uint8_t, 1> sink_state{42};
+    writer.addNode(6, "source", 0.f, 0.f, sink_slots, sink_state);
+    writer.addLink(1, 4);
+    writer.addLink(5, 7);
+    writer.write(file, 8);
+}
+} // namespace
+
+TEST_CASE("snapshots are read back as written", "[snapshot]")
+{
+    const TempFile file{"dtdfeditor_snapshot_roundtrip.dtdf"};
+    writeTestSnapshot(file.path());
+
+    const snapshot::SnapshotReader reader{file.path()};
+    CHECK(reader.header().next_vertex_id == 8);
+    REQUIRE(reader.numKeys() == 2);
+    CHECK(reader.key(0) == "source");
+    CHECK(reader.key(1) == "filter");
+
+    const auto nodes = reader.nodes();
+    REQUIRE(nodes.size() == 3);
+    CHECK(nodes[0].id == 0);
+    CHECK(nodes[0].x == 10.f);
+    CHECK(nodes[0].y == 20.f);
+    CHECK(reader.key(nodes[2].key_index) == "source");
+    CHECK(reader.key(nodes[1].key_index) == "filter");
+
+    const auto source_slots = reader.slots(nodes[0]);
+    REQUIRE(source_slots.size() == 2);
+    CHECK(source_slots[1].id == 2);
+    CHECK(source_slots[1].type == 1);
+    REQUIRE(reader.slots(nodes[2]).size() == 1);
+    CHECK(reader.slots(nodes[2])[0].id == 7);
+
+    REQUIRE(reader.blob(nodes[0]).size() == 3);
+    CHECK(reader.blob(nodes[0])[2] == 3);
+    CHECK(reader.blob(nodes[1]).empty());
+    REQUIRE(reader.blob(nodes[2]).size() == 1);
+    CHECK(reader.blob(nodes[2])[0] == 42);
+
+    const auto links = reader.links();
+    REQUIRE(links.size() == 2);
+    CHECK(links[0].from == 1);
+    CHECK(links[0].to == 4);
+    CHECK(links[1].from == 5);
+    CHECK(links[1].to == 7);
+}
+
+TEST_CASE("truncated snapshots are rejected", "[snapshot]")
+{
+    const TempFile file{"dtdfeditor_snapshot_truncated.dtdf"};
+    writeTestSnapshot(file.path());
+    const auto data = readFile(file.path());
+
+    // the links are the last section, so every cut removes data which the header refers to
+    for (std::size_t size = 0; size < data.size(); size++)
+    {
+        writeFile(file.path(), std::vector<char>(data.begin(), data.begin() + size));
+        CAPTURE(size);
+        CHECK_THROWS_AS(snapshot::SnapshotReader{file.path()}, std::runtime_error);
+    }
+}
+
+TEST_CASE("corrupt snapshots are rejected", "[snapshot]")
+{
+    const TempFile file{"dtdfeditor_snapshot_corrupt.dtdf"};
+    writeTestSnapshot(file.path());
+    const auto data = readFile(file.path());
+    const auto header = snapshot::SnapshotReader{file.path()}.header();
+
+    const auto check_rejected = [&file](const std::vector<char> &corrupt) {
+        writeFile(file.path(), corrupt);
+        CHECK_THROWS_AS(snapshot::SnapshotReader{file.path()}, std::runtime_error);
+    };
+
+    SECTION("magic")
+    {
+        auto corrupt = data;
+        corrupt[0] = 'X';
+        check_rejected(corrupt);
+    }
+    SECTION("version")
+    {
+        auto corrupt = data;
+        patch(corrupt, offsetof(snapshot::Header, version), snapshot::kVersion + 1);
+        check_rejected(corrupt);
+    }
+    SECTION("section beyond the end of the file")
+    {
+        auto corrupt = data;
+        patch(corrupt,
+              offsetof(snapshot::Header, blobs),
+              snapshot::SectionRef{header.blobs.offset, header.blobs.count + data.size()});
+        check_rejected(corrupt);
+    }
+    SECTION("misaligned section")
+    {
+        auto corrupt = data;
+        patch(corrupt, offsetof(snapshot::Header, nodes), snapshot::SectionRef{header.nodes.offset + 4, 1});
+        check_rejected(corrupt);
+    }
+    SECTION("node key index")
+    {
+        auto corrupt = data;
+        patch(corrupt, header.nodes.offset + offsetof(snapshot::NodeRecord, key_index), std::uint32_t{2});
+        check_rejected(corrupt);
+    }
+    SECTION("node slots")
+    {
+        auto corrupt = data;
+        patch(corrupt, header.nodes.offset + offsetof(snapshot::NodeRecord, slot_count), std::uint64_t{100});
+        check_rejected(corrupt);
+    }
+    SECTION("node state")
+    {
+        auto corrupt = data;
+        patch(corrupt, header.nodes.offset + offsetof(snapshot::NodeRecord, blob_offset), std::uint64_t{3});
+        check_rejected(corrupt);
+    }
+    SECTION("key characters")
+    {
+        auto corrupt = data;
+        patch(corrupt, header.keys.offset + offsetof(snapshot::KeyRecord, size), std::uint64_t{1000});
+        check_rejected(corrupt);
+    }
+}
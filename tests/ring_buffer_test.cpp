@@ -0,0 +1,134 @@
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "ring_buffer.hpp"
+
+using namespace dt::df::editor;
+
+namespace
+{
+//! small enough that the producers have to wait for the consumers all the time
+constexpr std::size_t kCapacity = 8;
+constexpr std::uint64_t kItems = 20'000;
+constexpr std::uint64_t kProducers = 4;
+constexpr std::uint64_t kConsumers = 2;
+
+//! every producer pushes (producer << 32) | sequence, so that the consumers can check the order per producer
+template <typename Ring>
+void checkMultiProducerTransfer(Ring &ring)
+{
+    std::vector<std::jthread> producers;
+    for (std::uint64_t producer = 0; producer < kProducers; producer++)
+    {
+        producers.emplace_back([&ring, producer] {
+            for (std::uint64_t i = 0; i < kItems; i++)
+                ring.push((producer << 32) | i);
+        });
+    }
+
+    std::array<std::uint64_t, kConsumers> sums{};
+    std::array<bool, kConsumers> in_order{};
+    {
+        std::vector<std::jthread> consumers;
+        for (std::uint64_t consumer = 0; consumer < kConsumers; consumer++)
+        {
+            consumers.emplace_back([&ring, &sums, &in_order, consumer] {
+                std::array<std::int64_t, kProducers> last_sequence;
+                last_sequence.fill(-1);
+                bool ordered = true;
+                for (std::uint64_t i = 0; i < kProducers * kItems / kConsumers; i++)
+                {
+                    const auto item = ring.pop();
+                    const auto sequence = static_cast<std::int64_t>(item & 0xffff'ffff);
+                    ordered = ordered && sequence > last_sequence[item >> 32];
+                    last_sequence[item >> 32] = sequence;
+                    sums[consumer] += item & 0xffff'ffff;
+                }
+                in_order[consumer] = ordered;
+            });
+        }
+    }
+
+    CHECK(std::accumulate(sums.begin(), sums.end(), std::uint64_t{0}) == kProducers * kItems * (kItems - 1) / 2);
+    for (const auto ordered : in_order)
+        CHECK(ordered);
+    CHECK(ring.size() == 0);
+}
+} // namespace
+
+TEST_CASE("SpscRing keeps the FIFO order", "[ring_buffer]")
+{
+    SpscRing<std::uint64_t> ring{kCapacity};
+    REQUIRE(ring.capacity() == kCapacity);
+
+    std::jthread producer{[&ring] {
+        std::array<std::uint64_t, 3> batch;
+        for (std::uint64_t i = 0; i < kItems; i += batch.size())
+        {
+            std::iota(batch.begin(), batch.end(), i);
+            ring.push(std::span<const std::uint64_t>{batch});
+        }
+    }};
+
+    std::uint64_t expected = 0;
+    bool in_order = true;
+    std::array<std::uint64_t, 5> items;
+    while (expected < kItems)
+    {
+        const auto count = ring.pop(std::span<std::uint64_t>{items});
+        for (std::size_t i = 0; i < count; i++)
+            in_order = in_order && items[i] == expected++;
+    }
+    CHECK(in_order);
+}
+
+TEST_CASE("SpscRing rejects pushes while full and pops while empty", "[ring_buffer]")
+{
+    SpscRing<int> ring{3};
+    REQUIRE(ring.capacity() == 4);
+    int item = -1;
+    CHECK_FALSE(ring.tryPop(item));
+    for (int i = 0; i < 4; i++)
+        REQUIRE(ring.tryPush(i));
+    CHECK_FALSE(ring.tryPush(4));
+    for (int i = 0; i < 4; i++)
+    {
+        REQUIRE(ring.tryPop(item));
+        CHECK(item == i);
+    }
+    CHECK_FALSE(ring.tryPop(item));
+}
+
+TEST_CASE("MpmcRing keeps the FIFO order of a single thread", "[ring_buffer]")
+{
+    MpmcRing<int> ring{kCapacity};
+    const std::array<int, 6> items{1, 2, 3, 4, 5, 6};
+    REQUIRE(ring.tryPush(std::span<const int>{items}) == items.size());
+    CHECK(ring.size() == items.size());
+
+    std::array<int, 10> popped{};
+    REQUIRE(ring.tryPop(std::span<int>{popped}) == items.size());
+    for (std::size_t i = 0; i < items.size(); i++)
+        CHECK(popped[i] == items[i]);
+
+    for (int i = 0; i < static_cast<int>(kCapacity); i++)
+        REQUIRE(ring.tryPush(i));
+    CHECK_FALSE(ring.tryPush(-1));
+}
+
+TEST_CASE("MpmcRing loses no item with several producers and consumers", "[ring_buffer]")
+{
+    SECTION("spin then park")
+    {
+        MpmcRing<std::uint64_t> ring{kCapacity, WaitStrategy::spin_then_park};
+        checkMultiProducerTransfer(ring);
+    }
+    SECTION("yield")
+    {
+        MpmcRing<std::uint64_t> ring{kCapacity, WaitStrategy::yield};
+        checkMultiProducerTransfer(ring);
+    }
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "spatial_grid.hpp"
+
+using namespace dt::df;
+using namespace dt::df::editor;
+
+namespace
+{
+bool intersects(const NodeRect &lhs, const NodeRect &rhs)
+{
+    return lhs.x <= rhs.x + rhs.width && rhs.x <= lhs.x + lhs.width && lhs.y <= rhs.y + rhs.height &&
+           rhs.y <= lhs.y + lhs.height;
+}
+
+std::vector<NodeId> bruteForceQuery(const std::map<NodeId, NodeRect> &rects, const NodeRect &area)
+{
+    std::vector<NodeId> result;
+    for (const auto &[id, rect] : rects)
+    {
+        if (intersects(rect, area))
+            result.emplace_back(id);
+    }
+    return result;
+}
+
+std::vector<NodeId> gridQuery(const NodeSpatialGrid &grid, const NodeRect &area)
+{
+    std::vector<NodeId> result;
+    grid.query(area, result);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+} // namespace
+
+TEST_CASE("NodeSpatialGrid reports a node spanning several cells once", "[spatial_grid]")
+{
+    NodeSpatialGrid grid{100.f};
+    grid.update(1, NodeRect{-150.f, -150.f, 400.f, 400.f});
+    grid.update(2, NodeRect{500.f, 500.f, 10.f, 10.f});
+    CHECK(gridQuery(grid, NodeRect{-1000.f, -1000.f, 2000.f, 2000.f}) == std::vector<NodeId>{1, 2});
+    CHECK(gridQuery(grid, NodeRect{200.f, 200.f, 10.f, 10.f}) == std::vector<NodeId>{1});
+    CHECK(gridQuery(grid, NodeRect{300.f, 300.f, 100.f, 100.f}).empty());
+
+    grid.update(1, NodeRect{450.f, 450.f, 100.f, 100.f});
+    CHECK(gridQuery(grid, NodeRect{200.f, 200.f, 10.f, 10.f}).empty());
+    CHECK(gridQuery(grid, NodeRect{505.f, 505.f, 1.f, 1.f}) == std::vector<NodeId>{1, 2});
+    grid.remove(2);
+    CHECK(gridQuery(grid, NodeRect{505.f, 505.f, 1.f, 1.f}) == std::vector<NodeId>{1});
+    CHECK(grid.size() == 1);
+}
+
+TEST_CASE("NodeSpatialGrid queries match a brute force scan", "[spatial_grid]")
+{
+    constexpr int kNodes = 2'000;
+    constexpr int kRounds = 2'000;
+    std::mt19937 random{3};
+    std::uniform_real_distribution<float> position{-5'000.f, 5'000.f};
+    std::uniform_real_distribution<float> size{0.f, 800.f};
+    std::uniform_int_distribution<NodeId> random_node{0, kNodes - 1};
+
+    NodeSpatialGrid grid{256.f};
+    std::map<NodeId, NodeRect> rects;
+    const auto randomRect = [&] { return NodeRect{position(random), position(random), size(random), size(random)}; };
+    for (NodeId id = 0; id < kNodes; id++)
+    {
+        rects[id] = randomRect();
+        grid.update(id, rects[id]);
+    }
+
+    for (int round = 0; round < kRounds; round++)
+    {
+        const auto id = random_node(random);
+        switch (random() % 4)
+        {
+        case 0:
+            grid.remove(id);
+            rects.erase(id);
+            break;
+        case 1:
+            // small moves mostly stay in the same cells
+            if (auto rect_it = rects.find(id); rect_it != rects.end())
+            {
+                rect_it->second.x += 10.f;
+                grid.update(id, rect_it->second);
+            }
+            break;
+        default:
+            rects[id] = randomRect();
+            grid.update(id, rects[id]);
+            break;
+        }
+
+        const NodeRect area{position(random), position(random), 4.f * size(random), 4.f * size(random)};
+        REQUIRE(gridQuery(grid, area) == bruteForceQuery(rects, area));
+    }
+    CHECK(grid.size() == rects.size());
+    for (const auto &[id, rect] : rects)
+    {
+        REQUIRE(grid.contains(id));
+        CHECK(grid.rect(id)->x == rect.x);
+    }
+}
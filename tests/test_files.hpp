@@ -0,0 +1,47 @@
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+namespace dt::df::editor::test
+{
+//! path in the temp directory. the file is removed when the test starts and when it ends.
+class TempFile
+{
+  public:
+    explicit TempFile(const char *name)
+        : path_{std::filesystem::temp_directory_path() / name}
+    {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+    TempFile(const TempFile &) = delete;
+    TempFile &operator=(const TempFile &) = delete;
+    ~TempFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+    const std::filesystem::path &path() const
+    {
+        return path_;
+    }
+
+  private:
+    std::filesystem::path path_;
+};
+
+inline std::vector<char> readFile(const std::filesystem::path &file)
+{
+    std::ifstream in{file, std::ios::binary};
+    return std::vector<char>{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+inline void writeFile(const std::filesystem::path &file, const std::vector<char> &data)
+{
+    std::ofstream out{file, std::ios::binary | std::ios::trunc};
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+} // namespace dt::df::editor::test
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <set>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "topological_order.hpp"
+
+using namespace dt::df;
+using namespace dt::df::editor;
+
+namespace
+{
+//! the links are counted, so one entry per link
+using Edges = std::multiset<std::pair<NodeId, NodeId>>;
+
+bool respectsEdges(const TopologicalOrder &order, const Edges &edges, const std::size_t num_nodes)
+{
+    const auto nodes = order.order();
+    if (nodes.size() != num_nodes)
+        return false;
+    std::unordered_map<NodeId, std::size_t> index;
+    for (std::size_t i = 0; i < nodes.size(); i++)
+        index.emplace(nodes[i], i);
+    return std::all_of(edges.begin(), edges.end(), [&index](const auto &edge) {
+        return index.at(edge.first) < index.at(edge.second);
+    });
+}
+} // namespace
+
+TEST_CASE("TopologicalOrder rejects cycles", "[topological_order]")
+{
+    TopologicalOrder order;
+    for (NodeId id = 0; id < 4; id++)
+        order.addNode(id);
+    REQUIRE(order.addDependency(0, 1));
+    REQUIRE(order.addDependency(1, 2));
+    REQUIRE(order.addDependency(2, 3));
+
+    CHECK_FALSE(order.addDependency(3, 0));
+    CHECK_FALSE(order.addDependency(2, 1));
+    CHECK_FALSE(order.addDependency(1, 1));
+    CHECK(order.order() == std::vector<NodeId>{0, 1, 2, 3});
+
+    // the rejected dependencies left nothing behind, so the chain can be reversed once it is gone
+    order.removeDependency(0, 1);
+    order.removeDependency(1, 2);
+    order.removeDependency(2, 3);
+    REQUIRE(order.addDependency(3, 2));
+    REQUIRE(order.addDependency(2, 1));
+    REQUIRE(order.addDependency(1, 0));
+    CHECK(order.order() == std::vector<NodeId>{3, 2, 1, 0});
+}
+
+TEST_CASE("TopologicalOrder counts several links between the same nodes", "[topological_order]")
+{
+    TopologicalOrder order;
+    order.addNode(0);
+    order.addNode(1);
+    REQUIRE(order.addDependency(0, 1));
+    REQUIRE(order.addDependency(0, 1));
+    CHECK(order.numPredecessors(1) == 1);
+
+    order.removeDependency(0, 1);
+    CHECK_FALSE(order.addDependency(1, 0));
+    order.removeDependency(0, 1);
+    CHECK(order.numPredecessors(1) == 0);
+    CHECK(order.addDependency(1, 0));
+}
+
+TEST_CASE("TopologicalOrder respects every edge after random edits", "[topological_order]")
+{
+    constexpr std::size_t kNodes = 200;
+    constexpr int kEdits = 20'000;
+    std::mt19937 random{7};
+    std::uniform_int_distribution<NodeId> random_node{0, kNodes - 1};
+
+    TopologicalOrder order;
+    for (NodeId id = 0; id < static_cast<NodeId>(kNodes); id++)
+        order.addNode(id);
+    Edges edges;
+    std::vector<std::pair<NodeId, NodeId>> links;
+
+    std::size_t rejected = 0;
+    for (int edit = 0; edit < kEdits; edit++)
+    {
+        if (links.empty() || random() % 3 != 0)
+        {
+            const auto from = random_node(random);
+            const auto to = random_node(random);
+            if (order.addDependency(from, to))
+            {
+                edges.emplace(from, to);
+                links.emplace_back(from, to);
+            }
+            else
+                rejected++;
+        }
+        else
+        {
+            const auto link_index = random() % links.size();
+            const auto link = links[link_index];
+            order.removeDependency(link.first, link.second);
+            edges.erase(edges.find(link));
+            links[link_index] = links.back();
+            links.pop_back();
+        }
+        if (edit % 1000 == 0)
+            REQUIRE(respectsEdges(order, edges, kNodes));
+    }
+    CHECK(rejected > 0);
+    CHECK(respectsEdges(order, edges, kNodes));
+
+    // removing a node drops its dependencies
+    const auto removed = links.front().first;
+    order.removeNode(removed);
+    std::erase_if(edges, [removed](const auto &edge) {
+        return edge.first == removed || edge.second == removed;
+    });
+    CHECK(respectsEdges(order, edges, kNodes - 1));
+}